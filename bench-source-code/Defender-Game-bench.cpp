@@ -0,0 +1,421 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Simulation.h"
+#include "HighScore.h"
+#include "LanderSystem.h"
+#include "SpatialGrid.h"
+#include "BatchIntersect.h"
+#include "CollisionSystem.h"
+
+// Times the game's hot loops at entity counts from 10 to 100k and prints the results as JSON.
+// Each benchmark builds its entities once, then repeats one pass over all of them until at
+// least MIN_BENCH_TIME has passed, so small counts are not lost in timer resolution.
+//
+// usage: bench [--out FILE] [--max-count N]
+
+const std::vector<int> ENTITY_COUNTS = {10, 100, 1000, 10000, 100000};
+const double MIN_BENCH_TIME = 0.2; // seconds of repeated passes per measurement
+const int NUM_HUMANOIDS = 5;       // the game's own humanoid count
+const int HIGH_SCORE_MAX_COUNT = 1000; // every call rewrites the file, so larger counts only take longer
+const char *const HIGH_SCORES_FILE = "highscores.txt";
+
+struct BenchResult
+{
+    std::string name;
+    int count;
+    long passes;
+    double nsPerPass;
+};
+
+struct Benchmark
+{
+    std::function<BenchResult(int)> run;
+    int maxCount; // the largest entity count worth running
+};
+
+// runs pass() until MIN_BENCH_TIME has passed and returns the average time of one pass
+BenchResult measure(const std::string &name, int count, const std::function<void()> &pass)
+{
+    typedef std::chrono::steady_clock Clock;
+    pass(); // warm up caches and let the first-call work happen outside the timing
+
+    long passes = 0;
+    Clock::time_point start = Clock::now();
+    std::chrono::duration<double> elapsed(0);
+    while (elapsed.count() < MIN_BENCH_TIME)
+    {
+        pass();
+        passes++;
+        elapsed = Clock::now() - start;
+    }
+    return {name, count, passes, elapsed.count() * 1e9 / passes};
+}
+
+BenchResult benchProjectileIntegrate(int count)
+{
+    // half lasers flying both ways and half missiles, as in the game; nothing is culled between passes
+    ProjectileStore projectiles(sf::FloatRect(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT), count);
+    for (int i = 0; i < count; i++)
+    {
+        sf::Vector2f position(static_cast<float>(i % WINDOW_WIDTH), 100.0f);
+        if (i % 2 == 0)
+        {
+            projectiles.spawnLaser(position, i % 4 == 0);
+        }
+        else
+        {
+            projectiles.spawnMissile(position, sf::Vector2f(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2));
+        }
+    }
+    return measure("ProjectileStore::integrate", count, [&]()
+                   { projectiles.integrate(SIM_TIME_STEP); });
+}
+
+// spawns a whole wave up front, humanoids first as in the game
+void spawnHorde(Simulation &simulation, int numLanders, int numHumanoids)
+{
+    for (int i = 0; i < numHumanoids; i++)
+    {
+        simulation.spawnHumanoids();
+    }
+    for (int i = 0; i < numLanders; i++)
+    {
+        simulation.spawnLander();
+    }
+}
+
+// numThreads 0 runs the landers on every core, so the threaded results only differ on a multi-core machine
+BenchResult measureUpdateLanders(int count, const char *name, unsigned int numThreads)
+{
+    SimConfig config;
+    config.maxLanders = count;
+    config.maxHumanoids = NUM_HUMANOIDS;
+    Simulation simulation(config);
+    spawnHorde(simulation, count, NUM_HUMANOIDS);
+    WorkerPool workers(numThreads);
+    return measure(name, count, [&]()
+                   { updateLanders(simulation.registry, SIM_TIME_STEP, workers); });
+}
+
+BenchResult benchUpdateLanders(int count)
+{
+    return measureUpdateLanders(count, "updateLanders", 1);
+}
+
+BenchResult benchUpdateLandersThreaded(int count)
+{
+    return measureUpdateLanders(count, "updateLandersThreaded", 0);
+}
+
+BenchResult measureAssignLanderTargets(int count, const char *name, unsigned int numThreads)
+{
+    // one humanoid per ten landers, so the humanoids grow with the wave and a full scan would show
+    int numHumanoids = count / 10 + 1;
+    SimConfig config;
+    config.maxLanders = count;
+    config.maxHumanoids = numHumanoids;
+    Simulation simulation(config);
+    spawnHorde(simulation, count, numHumanoids);
+    TargetIndex humanoids;
+    WorkerPool workers(numThreads);
+    return measure(name, count, [&]()
+                   { assignLanderTargets(simulation.registry, humanoids, workers); });
+}
+
+BenchResult benchAssignLanderTargets(int count)
+{
+    return measureAssignLanderTargets(count, "assignLanderTargets", 1);
+}
+
+BenchResult benchAssignLanderTargetsThreaded(int count)
+{
+    return measureAssignLanderTargets(count, "assignLanderTargetsThreaded", 0);
+}
+
+BenchResult benchFlockLanders(int count)
+{
+    SimConfig config;
+    config.maxLanders = count;
+    config.maxHumanoids = NUM_HUMANOIDS;
+    Simulation simulation(config);
+    spawnHorde(simulation, count, NUM_HUMANOIDS);
+    // a few updates first, so the landers are moving and spread as in a game rather than all in their spawn row
+    for (int i = 0; i < 60; i++)
+    {
+        simulation.update(SIM_TIME_STEP, InputState());
+    }
+    SpatialGrid neighbours(sf::FloatRect(-WINDOW_WIDTH, 0, 3 * WINDOW_WIDTH, WINDOW_HEIGHT), FLOCK_RADIUS);
+    WorkerPool workers(1);
+    return measure("flockLanders", count, [&]()
+                   { flockLanders(simulation.registry, neighbours, SIM_TIME_STEP, workers); });
+}
+
+BenchResult benchCheckLanderHumanoidCollisions(int count)
+{
+    SimConfig config;
+    config.maxLanders = count;
+    config.maxHumanoids = NUM_HUMANOIDS;
+    Simulation simulation(config);
+    for (int i = 0; i < NUM_HUMANOIDS; i++)
+    {
+        simulation.spawnHumanoids();
+    }
+    for (int i = 0; i < count; i++)
+    {
+        simulation.spawnLander();
+    }
+    return measure("Simulation::checkLanderHumanoidCollisions", count, [&]()
+                   { simulation.checkLanderHumanoidCollisions(); });
+}
+
+BenchResult benchLaserLanderBroadphase(int count)
+{
+    // landers spread over the screen mid-wave and one laser per ten landers, as the laser checks see them
+    Random random(1, 0);
+    std::vector<sf::FloatRect> landerBounds(count);
+    for (sf::FloatRect &bounds : landerBounds)
+    {
+        bounds = sf::FloatRect(static_cast<float>(random.nextInt(WINDOW_WIDTH)), static_cast<float>(random.nextInt(WINDOW_HEIGHT)), 120, 120);
+    }
+    std::vector<sf::FloatRect> laserBounds(count / 10 + 1);
+    for (sf::FloatRect &bounds : laserBounds)
+    {
+        bounds = sf::FloatRect(static_cast<float>(random.nextInt(WINDOW_WIDTH)), static_cast<float>(random.nextInt(WINDOW_HEIGHT)), 40, 5);
+    }
+
+    SpatialGrid grid(sf::FloatRect(-WINDOW_WIDTH, -PROJECTILE_CULL_MARGIN, 3 * WINDOW_WIDTH, WINDOW_HEIGHT + 2 * PROJECTILE_CULL_MARGIN), COLLISION_CELL_SIZE);
+    std::vector<std::uint32_t> candidates;
+    volatile std::size_t numHits = 0; // keeps the exact checks from being optimised away
+    return measure("SpatialGrid laser vs lander", count, [&]()
+                   {
+                       grid.clear();
+                       for (std::size_t i = 0; i < landerBounds.size(); i++)
+                       {
+                           grid.insert(static_cast<std::uint32_t>(i), landerBounds[i]);
+                       }
+                       grid.build();
+                       for (const sf::FloatRect &laser : laserBounds)
+                       {
+                           grid.queryOverlaps(laser, candidates);
+                           numHits = numHits + candidates.size();
+                       } });
+}
+
+// tests the player's box against count packed lander boxes, as intersectBoxes() sees them
+BenchResult benchPackedBoxes(const std::string &name, int count, void (*intersect)(const sf::FloatRect &, const float *, const float *, const float *, const float *, std::size_t, std::uint64_t *))
+{
+    Random random(1, 0);
+    std::vector<float> left(count), top(count), width(count, 120.0f), height(count, 120.0f);
+    for (int i = 0; i < count; i++)
+    {
+        left[i] = static_cast<float>(random.nextInt(WINDOW_WIDTH));
+        top[i] = static_cast<float>(random.nextInt(WINDOW_HEIGHT));
+    }
+    sf::FloatRect playerBounds(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f, 80, 40);
+    std::vector<std::uint64_t> hits(getNumHitWords(count));
+    return measure(name, count, [&]()
+                   { intersect(playerBounds, left.data(), top.data(), width.data(), height.data(), count, hits.data()); });
+}
+
+BenchResult benchIntersectBoxesScalar(int count)
+{
+    return benchPackedBoxes("intersectBoxesScalar", count, intersectBoxesScalar);
+}
+
+BenchResult benchIntersectBoxes(int count)
+{
+    return benchPackedBoxes(std::string("intersectBoxes (") + getIntersectKernelName() + ")", count, intersectBoxes);
+}
+
+// count collision events spread over every pair, in a fixed shuffled order
+std::vector<CollisionEvent> makeCollisionEvents(int count)
+{
+    const std::uint8_t pairs[] = {LAYER_LASER | LAYER_HUMANOID, LAYER_LASER | LAYER_LANDER, LAYER_MISSILE | LAYER_PLAYER, LAYER_PLAYER | LAYER_LANDER};
+    Random random(1, 0);
+    std::vector<CollisionEvent> collisions(count);
+    for (int i = 0; i < count; i++)
+    {
+        collisions[i] = {pairs[random.nextInt(4)], static_cast<std::uint32_t>(i), static_cast<Entity>(i)};
+    }
+    return collisions;
+}
+
+BenchResult benchCollisionMatrixDispatch(int count)
+{
+    // each response only sums its event, so the time is the dispatch itself
+    std::vector<CollisionEvent> collisions = makeCollisionEvents(count);
+    std::uint32_t sums[4] = {};
+    volatile std::uint32_t total = 0;
+    return measure("GameCollisions::dispatch", count, [&]()
+                   {
+                       for (const CollisionEvent &collision : collisions)
+                       {
+                           GameCollisions::dispatch(collision.layers, [&](auto pair)
+                                                    { sums[decltype(pair)::first == LAYER_PLAYER ? 3 : decltype(pair)::second == LAYER_PLAYER ? 2 : decltype(pair)::second == LAYER_LANDER ? 1 : 0] += collision.index; });
+                       }
+                       total = total + sums[0] + sums[1] + sums[2] + sums[3]; });
+}
+
+BenchResult benchCollisionSwitchDispatch(int count)
+{
+    // the hand-written switch the matrix replaced, with the same responses
+    std::vector<CollisionEvent> collisions = makeCollisionEvents(count);
+    std::uint32_t sums[4] = {};
+    volatile std::uint32_t total = 0;
+    return measure("switch dispatch", count, [&]()
+                   {
+                       for (const CollisionEvent &collision : collisions)
+                       {
+                           switch (collision.layers)
+                           {
+                           case LAYER_LASER | LAYER_HUMANOID:
+                               sums[0] += collision.index;
+                               break;
+                           case LAYER_LASER | LAYER_LANDER:
+                               sums[1] += collision.index;
+                               break;
+                           case LAYER_MISSILE | LAYER_PLAYER:
+                               sums[2] += collision.index;
+                               break;
+                           case LAYER_PLAYER | LAYER_LANDER:
+                               sums[3] += collision.index;
+                               break;
+                           }
+                       }
+                       total = total + sums[0] + sums[1] + sums[2] + sums[3]; });
+}
+
+BenchResult benchTimerWheel(int count)
+{
+    // count cooldowns that each fire and reschedule themselves every 0.5 to 10 seconds, as the game's do
+    TimerWheel timers;
+    Random random(1, 0);
+    std::vector<std::function<void()>> repeats(count);
+    for (int i = 0; i < count; i++)
+    {
+        float period = 0.5f + random.nextFloat() * 9.5f;
+        repeats[i] = [&timers, &repeats, i, period]()
+        { timers.schedule(period, repeats[i]); };
+        timers.schedule(period, repeats[i]);
+    }
+    return measure("TimerWheel::advance", count, [&]()
+                   { timers.advance(SIM_TIME_STEP); });
+}
+
+BenchResult benchAddHighScore(int count)
+{
+    // one pass adds count scores, each of which sorts the table and rewrites the file
+    return measure("HighScore::addHighScore", count, [&]()
+                   {
+                       HighScore highScores;
+                       for (int i = 0; i < count; i++)
+                       {
+                           highScores.addHighScore("bench", i);
+                       } });
+}
+
+std::string readFile(const std::string &filename, bool &exists)
+{
+    std::ifstream file(filename, std::ios::binary);
+    exists = file.is_open();
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+void writeJson(std::ostream &out, const std::vector<BenchResult> &results)
+{
+    out << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &result = results[i];
+        out << "    {\"name\": \"" << result.name << "\", \"count\": " << result.count
+            << ", \"passes\": " << result.passes << ", \"ns_per_pass\": " << result.nsPerPass
+            << ", \"ns_per_entity\": " << result.nsPerPass / result.count << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char *argv[])
+{
+    std::string outFile;
+    int maxCount = ENTITY_COUNTS.back();
+    for (int i = 1; i < argc; i += 2)
+    {
+        std::string option = argv[i];
+        if (i + 1 < argc && option == "--out")
+        {
+            outFile = argv[i + 1];
+        }
+        else if (i + 1 < argc && option == "--max-count")
+        {
+            maxCount = std::stoi(argv[i + 1]);
+        }
+        else
+        {
+            std::cerr << "usage: bench [--out FILE] [--max-count N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // addHighScore rewrites the high score file, so keep the player's scores and put them back afterwards
+    bool hadHighScores = false;
+    std::string savedHighScores = readFile(HIGH_SCORES_FILE, hadHighScores);
+
+    int largest = ENTITY_COUNTS.back();
+    std::vector<Benchmark> benchmarks = {
+        {benchProjectileIntegrate, largest},
+        {benchUpdateLanders, largest},
+        {benchUpdateLandersThreaded, largest},
+        {benchAssignLanderTargets, largest},
+        {benchAssignLanderTargetsThreaded, largest},
+        {benchFlockLanders, largest},
+        {benchCheckLanderHumanoidCollisions, largest},
+        {benchLaserLanderBroadphase, largest},
+        {benchIntersectBoxesScalar, largest},
+        {benchIntersectBoxes, largest},
+        {benchCollisionSwitchDispatch, largest},
+        {benchCollisionMatrixDispatch, largest},
+        {benchTimerWheel, largest},
+        {benchAddHighScore, HIGH_SCORE_MAX_COUNT}};
+
+    std::vector<BenchResult> results;
+    for (const auto &benchmark : benchmarks)
+    {
+        for (int count : ENTITY_COUNTS)
+        {
+            if (count <= maxCount && count <= benchmark.maxCount)
+            {
+                results.push_back(benchmark.run(count));
+                std::cerr << results.back().name << " x" << count << ": " << results.back().nsPerPass / 1e6 << " ms" << std::endl;
+            }
+        }
+    }
+
+    if (hadHighScores)
+    {
+        std::ofstream(HIGH_SCORES_FILE, std::ios::binary) << savedHighScores;
+    }
+    else
+    {
+        std::remove(HIGH_SCORES_FILE);
+    }
+
+    if (outFile.empty())
+    {
+        writeJson(std::cout, results);
+    }
+    else
+    {
+        std::ofstream file(outFile);
+        writeJson(file, results);
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "BatchIntersect.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BATCH_INTERSECT_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(BATCH_INTERSECT_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_INTERSECT_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    typedef void (*IntersectKernel)(const sf::FloatRect &, const float *, const float *, const float *, const float *, std::size_t, std::uint64_t *);
+
+    // tests boxes first to count - 1 one at a time and sets their bits, which the caller has cleared
+    void intersectRange(const sf::FloatRect &box, const float *left, const float *top, const float *width, const float *height,
+                        std::size_t first, std::size_t count, std::uint64_t *hits)
+    {
+        float boxRight = box.left + box.width;
+        float boxBottom = box.top + box.height;
+        for (std::size_t i = first; i < count; i++)
+        {
+            // the overlap on each axis must be wider than nothing, as in sf::FloatRect::intersects
+            bool hit = std::max(box.left, left[i]) < std::min(boxRight, left[i] + width[i]) &&
+                       std::max(box.top, top[i]) < std::min(boxBottom, top[i] + height[i]);
+            hits[i / 64] |= static_cast<std::uint64_t>(hit) << (i % 64);
+        }
+    }
+
+    void scalarKernel(const sf::FloatRect &box, const float *left, const float *top, const float *width, const float *height,
+                      std::size_t count, std::uint64_t *hits)
+    {
+        std::fill(hits, hits + getNumHitWords(count), 0);
+        intersectRange(box, left, top, width, height, 0, count, hits);
+    }
+
+#ifdef BATCH_INTERSECT_SSE2
+    void sse2Kernel(const sf::FloatRect &box, const float *left, const float *top, const float *width, const float *height,
+                    std::size_t count, std::uint64_t *hits)
+    {
+        std::fill(hits, hits + getNumHitWords(count), 0);
+        const __m128 boxLeft = _mm_set1_ps(box.left);
+        const __m128 boxTop = _mm_set1_ps(box.top);
+        const __m128 boxRight = _mm_set1_ps(box.left + box.width);
+        const __m128 boxBottom = _mm_set1_ps(box.top + box.height);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 l = _mm_loadu_ps(left + i);
+            __m128 t = _mm_loadu_ps(top + i);
+            __m128 r = _mm_add_ps(l, _mm_loadu_ps(width + i));
+            __m128 b = _mm_add_ps(t, _mm_loadu_ps(height + i));
+            __m128 overlapX = _mm_cmplt_ps(_mm_max_ps(boxLeft, l), _mm_min_ps(boxRight, r));
+            __m128 overlapY = _mm_cmplt_ps(_mm_max_ps(boxTop, t), _mm_min_ps(boxBottom, b));
+            std::uint64_t mask = static_cast<std::uint64_t>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)));
+            hits[i / 64] |= mask << (i % 64); // 4 bits never straddle two words, as i is a multiple of 4
+        }
+        intersectRange(box, left, top, width, height, i, count, hits);
+    }
+#endif
+
+#ifdef BATCH_INTERSECT_AVX2
+    __attribute__((target("avx2"))) void avx2Kernel(const sf::FloatRect &box, const float *left, const float *top, const float *width,
+                                                     const float *height, std::size_t count, std::uint64_t *hits)
+    {
+        std::fill(hits, hits + getNumHitWords(count), 0);
+        const __m256 boxLeft = _mm256_set1_ps(box.left);
+        const __m256 boxTop = _mm256_set1_ps(box.top);
+        const __m256 boxRight = _mm256_set1_ps(box.left + box.width);
+        const __m256 boxBottom = _mm256_set1_ps(box.top + box.height);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 l = _mm256_loadu_ps(left + i);
+            __m256 t = _mm256_loadu_ps(top + i);
+            __m256 r = _mm256_add_ps(l, _mm256_loadu_ps(width + i));
+            __m256 b = _mm256_add_ps(t, _mm256_loadu_ps(height + i));
+            __m256 overlapX = _mm256_cmp_ps(_mm256_max_ps(boxLeft, l), _mm256_min_ps(boxRight, r), _CMP_LT_OQ);
+            __m256 overlapY = _mm256_cmp_ps(_mm256_max_ps(boxTop, t), _mm256_min_ps(boxBottom, b), _CMP_LT_OQ);
+            std::uint64_t mask = static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY)));
+            hits[i / 64] |= mask << (i % 64); // 8 bits never straddle two words, as i is a multiple of 8
+        }
+        intersectRange(box, left, top, width, height, i, count, hits);
+    }
+#endif
+
+    struct KernelChoice
+    {
+        IntersectKernel kernel;
+        const char *name;
+    };
+
+    // this asks the processor once which instruction sets it has
+    KernelChoice chooseKernel()
+    {
+#ifdef BATCH_INTERSECT_AVX2
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return {avx2Kernel, "avx2"};
+        }
+#endif
+#ifdef BATCH_INTERSECT_SSE2
+        return {sse2Kernel, "sse2"};
+#else
+        return {scalarKernel, "scalar"};
+#endif
+    }
+
+    const KernelChoice &getKernelChoice()
+    {
+        static const KernelChoice choice = chooseKernel();
+        return choice;
+    }
+}
+
+void intersectBoxes(const sf::FloatRect &box, const float *left, const float *top, const float *width, const float *height,
+                    std::size_t count, std::uint64_t *hits)
+{
+    getKernelChoice().kernel(box, left, top, width, height, count, hits);
+}
+
+void intersectBoxesScalar(const sf::FloatRect &box, const float *left, const float *top, const float *width, const float *height,
+                          std::size_t count, std::uint64_t *hits)
+{
+    scalarKernel(box, left, top, width, height, count, hits);
+}
+
+const char *getIntersectKernelName()
+{
+    return getKernelChoice().name;
+}
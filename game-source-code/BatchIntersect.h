@@ -0,0 +1,79 @@
+#ifndef BATCHINTERSECT_H
+#define BATCHINTERSECT_H
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Get the number of 64 bit words a hit mask for some boxes needs.
+ *
+ * @param count The number of boxes.
+ * @return The number of words.
+ */
+inline std::size_t getNumHitWords(std::size_t count)
+{
+    return (count + 63) / 64;
+}
+
+/**
+ * @brief Get the lowest set bit of a hit mask word.
+ *
+ * @param word The word, which must not be 0.
+ * @return The place of the lowest set bit, from 0 to 63.
+ */
+inline unsigned getLowestHit(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned bit = 0;
+    while ((word & 1) == 0)
+    {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Test one box against many packed boxes at once.
+ *
+ * The boxes are stored as four parallel arrays, like the fields of sf::FloatRect. A box hits when
+ * it overlaps the first one by more than an edge, exactly as sf::FloatRect::intersects decides it
+ * for boxes with no negative sizes. The test runs 8 boxes at a time with AVX2 or 4 with SSE2,
+ * whichever the processor supports, and one at a time elsewhere.
+ *
+ * @param box The box to test.
+ * @param left The left edges of the packed boxes.
+ * @param top The top edges of the packed boxes.
+ * @param width The widths of the packed boxes.
+ * @param height The heights of the packed boxes.
+ * @param count The number of packed boxes.
+ * @param hits Bit i of word i / 64 is set if box i hits; getNumHitWords(count) words are overwritten.
+ */
+void intersectBoxes(const sf::FloatRect &box, const float *left, const float *top, const float *width, const float *height,
+                    std::size_t count, std::uint64_t *hits);
+
+/**
+ * @brief Test one box against many packed boxes one at a time, as intersectBoxes() does without SIMD.
+ *
+ * @param box The box to test.
+ * @param left The left edges of the packed boxes.
+ * @param top The top edges of the packed boxes.
+ * @param width The widths of the packed boxes.
+ * @param height The heights of the packed boxes.
+ * @param count The number of packed boxes.
+ * @param hits Bit i of word i / 64 is set if box i hits; getNumHitWords(count) words are overwritten.
+ */
+void intersectBoxesScalar(const sf::FloatRect &box, const float *left, const float *top, const float *width, const float *height,
+                          std::size_t count, std::uint64_t *hits);
+
+/**
+ * @brief Get the name of the instruction set intersectBoxes() picked for this processor.
+ *
+ * @return "avx2", "sse2" or "scalar".
+ */
+const char *getIntersectKernelName();
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef COLLISIONMATRIX_H
+#define COLLISIONMATRIX_H
+#include <cstdint>
+
+/**
+ * @struct CollisionPair
+ * @brief Two collision layers, each one bit, whose members respond when they touch.
+ *
+ * The first layer is the one that goes looking for the second, such as a laser for landers.
+ */
+template <std::uint8_t First, std::uint8_t Second>
+struct CollisionPair
+{
+    static constexpr std::uint8_t first = First;
+    static constexpr std::uint8_t second = Second;
+    static constexpr std::uint8_t layers = First | Second; /**< The pair's key, as stored in a collision event. */
+};
+
+/**
+ * @struct CollisionMatrix
+ * @brief Every pair of layers that collide, declared once as a list of CollisionPair types.
+ *
+ * The detection loops and the responses are both generated from the list at compile
+ * time: each visit or dispatch unrolls into one test per pair that calls the pair's own code
+ * directly, so there is no table of function pointers and no virtual call. A new kind of entity
+ * only needs its pairs added to the list and a detection and response for each.
+ */
+template <typename... Pairs>
+struct CollisionMatrix
+{
+    /**
+     * @brief Call a visitor with every pair that a layer goes looking for, in the order they are listed.
+     *
+     * Only the matching pairs are compiled into the call, so the visitor need not handle the others.
+     *
+     * @param visit Called with a value of each CollisionPair type whose first layer is Layer.
+     */
+    template <std::uint8_t Layer, typename Visitor>
+    static void forEachPairFrom(Visitor &&visit)
+    {
+        (visitIfFrom<Layer, Pairs>(visit), ...);
+    }
+
+    /**
+     * @brief Call a responder with the one pair whose key matches some layers.
+     *
+     * @param layers The two layers that touched, ORed together.
+     * @param respond Called with a value of the matching CollisionPair type.
+     * @return True if a pair matched, false if the layers do not collide.
+     */
+    template <typename Responder>
+    static bool dispatch(std::uint8_t layers, Responder &&respond)
+    {
+        return ((layers == Pairs::layers && (respond(Pairs()), true)) || ...);
+    }
+
+private:
+    template <std::uint8_t Layer, typename Pair, typename Visitor>
+    static void visitIfFrom(Visitor &visit)
+    {
+        if constexpr (Pair::first == Layer)
+        {
+            visit(Pair());
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "CollisionSystem.h"
+#include "PixelMask.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+void updateBounds(Registry &registry)
+{
+    for (std::size_t i = 0; i < registry.bounds.size(); i++)
+    {
+        Entity entity = registry.bounds.getEntity(i);
+        registry.bounds[i].world = getWorldBounds(registry.transforms.get(entity), registry.colliders.get(entity));
+    }
+}
+
+void updateBounds(Registry &registry, Entity entity)
+{
+    registry.bounds.get(entity).world = getWorldBounds(registry.transforms.get(entity), registry.colliders.get(entity));
+}
+
+namespace
+{
+    // this finds the open range of times when two boxes overlap along one axis
+    bool overlapTimes(float movingStart, float movingSize, float velocity, float targetStart, float targetSize, float &enter, float &exit)
+    {
+        float movingEnd = movingStart + movingSize;
+        float targetEnd = targetStart + targetSize;
+        if (velocity == 0.0f)
+        {
+            enter = -std::numeric_limits<float>::infinity();
+            exit = std::numeric_limits<float>::infinity();
+            return std::max(movingStart, targetStart) < std::min(movingEnd, targetEnd);
+        }
+        enter = (targetStart - movingEnd) / velocity;
+        exit = (targetEnd - movingStart) / velocity;
+        if (velocity < 0.0f)
+        {
+            std::swap(enter, exit);
+        }
+        return true;
+    }
+}
+
+bool masksOverlap(const sf::FloatRect &firstBounds, const PixelMask *firstMask, const sf::FloatRect &secondBounds, const PixelMask *secondMask)
+{
+    if (!firstBounds.intersects(secondBounds))
+    {
+        return false;
+    }
+    if (firstMask == nullptr && secondMask == nullptr)
+    {
+        return true;
+    }
+    if (firstMask == nullptr)
+    {
+        return masksOverlap(secondBounds, secondMask, firstBounds, firstMask);
+    }
+    if (secondMask == nullptr)
+    {
+        // this covers every mask pixel the solid box touches at all
+        int left = static_cast<int>(std::floor(secondBounds.left - firstBounds.left));
+        int top = static_cast<int>(std::floor(secondBounds.top - firstBounds.top));
+        int right = static_cast<int>(std::ceil(secondBounds.left + secondBounds.width - firstBounds.left));
+        int bottom = static_cast<int>(std::ceil(secondBounds.top + secondBounds.height - firstBounds.top));
+        return firstMask->overlaps(sf::IntRect(left, top, right - left, bottom - top));
+    }
+    sf::Vector2i offset(static_cast<int>(std::round(secondBounds.left - firstBounds.left)), static_cast<int>(std::round(secondBounds.top - firstBounds.top)));
+    return firstMask->overlaps(*secondMask, offset);
+}
+
+bool sweepBoxes(const sf::FloatRect &moving, const sf::Vector2f &displacement, const sf::FloatRect &target, float &timeOfImpact)
+{
+    float enterX, exitX, enterY, exitY;
+    if (!overlapTimes(moving.left, moving.width, displacement.x, target.left, target.width, enterX, exitX) ||
+        !overlapTimes(moving.top, moving.height, displacement.y, target.top, target.height, enterY, exitY))
+    {
+        return false;
+    }
+
+    // the boxes overlap once they overlap on both axes, until they stop on either
+    float enter = std::max(enterX, enterY);
+    float exit = std::min(exitX, exitY);
+    if (enter >= exit || enter >= 1.0f || exit <= 0.0f)
+    {
+        return false;
+    }
+    timeOfImpact = std::max(enter, 0.0f);
+    return true;
+}
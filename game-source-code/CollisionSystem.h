@@ -0,0 +1,86 @@
+#ifndef COLLISIONSYSTEM_H
+#define COLLISIONSYSTEM_H
+#include "Registry.h"
+#include "CollisionMatrix.h"
+#include <cstdint>
+
+/**
+ * @enum CollisionLayer
+ * @brief The kinds of things that collide, as bits so the two layers of a pair fit in one key.
+ */
+enum CollisionLayer : std::uint8_t
+{
+    LAYER_PLAYER = 1 << 0,
+    LAYER_LASER = 1 << 1,
+    LAYER_MISSILE = 1 << 2,
+    LAYER_LANDER = 1 << 3,
+    LAYER_HUMANOID = 1 << 4
+};
+
+/**
+ * @brief Every pair of layers that collide in the game; pairs outside it are never tested. Earlier pairs win ties between equally early hits.
+ */
+typedef CollisionMatrix<CollisionPair<LAYER_LASER, LAYER_HUMANOID>,
+                        CollisionPair<LAYER_LASER, LAYER_LANDER>,
+                        CollisionPair<LAYER_MISSILE, LAYER_PLAYER>,
+                        CollisionPair<LAYER_PLAYER, LAYER_LANDER>>
+    GameCollisions;
+
+/**
+ * @struct CollisionEvent
+ * @brief One pair that touched during an update, waiting for its response.
+ *
+ * Detection only records these, so every response runs once, in one place, after every pair has
+ * been found.
+ */
+struct CollisionEvent
+{
+    std::uint8_t layers; /**< The two layers that touched, ORed together. */
+    std::uint32_t index; /**< The projectile's index, or 0 when neither side is a projectile. */
+    Entity entity;       /**< The lander or humanoid, or NO_ENTITY when neither side is one. */
+};
+
+/**
+ * @brief Refresh the world bounding box of every entity that collides, after they have all moved.
+ *
+ * @param registry The registry that holds the entities.
+ */
+void updateBounds(Registry &registry);
+
+/**
+ * @brief Refresh the world bounding box of one entity, after it was moved outside the usual update.
+ *
+ * @param registry The registry that holds the entity.
+ * @param entity The entity, which must have a Transform, a Collider and Bounds.
+ */
+void updateBounds(Registry &registry, Entity entity);
+
+/**
+ * @brief Check if two boxes overlap where both of them have a solid pixel.
+ *
+ * The boxes are tested first, so the masks are only read for pairs that already overlap.
+ *
+ * @param firstBounds The first box.
+ * @param firstMask The first box's solid pixels, or nullptr if all of them are solid.
+ * @param secondBounds The second box.
+ * @param secondMask The second box's solid pixels, or nullptr if all of them are solid.
+ * @return True if a pixel is solid in both, false otherwise.
+ */
+bool masksOverlap(const sf::FloatRect &firstBounds, const PixelMask *firstMask, const sf::FloatRect &secondBounds, const PixelMask *secondMask);
+
+/**
+ * @brief Find when a moving box first overlaps a still one, with a swept AABB test.
+ *
+ * The boxes overlap when they do by more than an edge, as in sf::FloatRect::intersects, so a box
+ * that only brushes the other's edge never hits it. A fast box that jumps clean over the other
+ * in one update is still found, however large the update's time step.
+ *
+ * @param moving The moving box where it started.
+ * @param displacement How far the moving box travelled in a straight line.
+ * @param target The still box.
+ * @param timeOfImpact Set to how far along its travel the moving box first overlapped, from 0 to 1.
+ * @return True if the boxes overlapped at any point of the travel, false otherwise.
+ */
+bool sweepBoxes(const sf::FloatRect &moving, const sf::Vector2f &displacement, const sf::FloatRect &target, float &timeOfImpact);
+
+#endif
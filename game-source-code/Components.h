@@ -0,0 +1,98 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+class PixelMask;
+
+/**
+ * @struct Transform
+ * @brief Where an entity is, now and after the update before last.
+ */
+struct Transform
+{
+    sf::Vector2f position;         /**< The position after the last update. */
+    sf::Vector2f previousPosition; /**< The position after the update before last, for interpolated drawing. */
+};
+
+/**
+ * @struct Velocity
+ * @brief How far an entity moves on its own each second.
+ */
+struct Velocity
+{
+    sf::Vector2f value; /**< Pixels per second. */
+};
+
+/**
+ * @struct Collider
+ * @brief An axis-aligned bounding box relative to the entity's position.
+ */
+struct Collider
+{
+    sf::Vector2f offset; /**< From the position to the top left corner of the box. */
+    sf::Vector2f size;   /**< Width and height of the box. */
+    const PixelMask *mask = nullptr; /**< Which pixels of the box are solid, or nullptr if all of them are. */
+};
+
+/**
+ * @struct Bounds
+ * @brief An entity's bounding box in the world, worked out from its Transform and Collider.
+ *
+ * Collision code reads this instead of working the box out again for every pair it checks. It is
+ * refreshed once after the entities move each update, by updateBounds().
+ */
+struct Bounds
+{
+    sf::FloatRect world; /**< The box, as of the last refresh. */
+};
+
+/**
+ * @struct LanderAI
+ * @brief What a lander is doing.
+ */
+struct LanderAI
+{
+    sf::Vector2f moveTarget;                    /**< Where the lander is heading. */
+    std::uint32_t targetHumanoid = 0xFFFFFFFFu; /**< The Entity of the humanoid it is after, or NO_ENTITY. */
+    sf::Vector2f steering;                      /**< The flocking added to its movement, in pixels per second. */
+    bool captured = false;                      /**< The lander is carrying a humanoid up. */
+    bool destroyed = false;                     /**< The lander was shot or crashed into the player. */
+    bool thinking = true;                       /**< It searches for a target and its neighbours this update. */
+};
+
+/**
+ * @struct HumanoidAI
+ * @brief What a humanoid is doing.
+ */
+struct HumanoidAI
+{
+    sf::Vector2f capturedPosition; /**< Where the lander or player carrying the humanoid is. */
+    bool captured = false;         /**< A lander or the player is carrying the humanoid. */
+    bool falling = false;          /**< The humanoid was dropped and is falling. */
+    bool destroyed = false;        /**< The humanoid was shot, dropped too far or carried away. */
+    bool playerCaptured = false;   /**< The player is the one carrying the humanoid. */
+};
+
+/**
+ * @struct Renderable
+ * @brief The sprite an entity is drawn with, shared by every entity that looks the same.
+ */
+struct Renderable
+{
+    const sf::Sprite *sprite = nullptr; /**< Texture, scale and origin to draw with; its position is ignored. */
+};
+
+/**
+ * @brief Get an entity's bounding box in the world.
+ *
+ * @param transform The entity's position.
+ * @param collider The entity's box relative to its position.
+ * @return The bounding box.
+ */
+inline sf::FloatRect getWorldBounds(const Transform &transform, const Collider &collider)
+{
+    return sf::FloatRect(transform.position + collider.offset, collider.size);
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <fstream>
+
+FrameProfiler::FrameProfiler() : next(0), numFrames(0)
+{
+    current.fill(0.0f);
+}
+
+void FrameProfiler::addTime(FramePhase phase, float milliseconds)
+{
+    current[phase] += milliseconds;
+}
+
+void FrameProfiler::endFrame()
+{
+    history[next] = current;
+    next = (next + 1) % FRAME_HISTORY_SIZE;
+    numFrames = std::min(numFrames + 1, FRAME_HISTORY_SIZE);
+    current.fill(0.0f);
+}
+
+std::size_t FrameProfiler::getNumFrames() const
+{
+    return numFrames;
+}
+
+const FrameProfiler::FrameSample &FrameProfiler::getFrame(std::size_t age) const
+{
+    return history[(next + FRAME_HISTORY_SIZE - 1 - age) % FRAME_HISTORY_SIZE];
+}
+
+float FrameProfiler::getAverage(FramePhase phase) const
+{
+    if (numFrames == 0)
+    {
+        return 0.0f;
+    }
+    float total = 0.0f;
+    for (std::size_t age = 0; age < numFrames; age++)
+    {
+        total += getFrame(age)[phase];
+    }
+    return total / numFrames;
+}
+
+float FrameProfiler::getMax(FramePhase phase) const
+{
+    float longest = 0.0f;
+    for (std::size_t age = 0; age < numFrames; age++)
+    {
+        longest = std::max(longest, getFrame(age)[phase]);
+    }
+    return longest;
+}
+
+bool FrameProfiler::saveToCsv(const std::string &filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << "frame";
+    for (int phase = 0; phase < NUM_FRAME_PHASES; phase++)
+    {
+        file << "," << getPhaseName(static_cast<FramePhase>(phase)) << "_ms";
+    }
+    file << "\n";
+
+    for (std::size_t i = 0; i < numFrames; i++)
+    {
+        const FrameSample &frame = getFrame(numFrames - 1 - i);
+        file << i;
+        for (float milliseconds : frame)
+        {
+            file << "," << milliseconds;
+        }
+        file << "\n";
+    }
+    return file.good();
+}
+
+const char *FrameProfiler::getPhaseName(FramePhase phase)
+{
+    switch (phase)
+    {
+    case PHASE_EVENTS:
+        return "events";
+    case PHASE_BACKGROUND:
+        return "background";
+    case PHASE_MINIMAP:
+        return "minimap";
+    case PHASE_LANDERS:
+        return "landers";
+    case PHASE_COLLISIONS:
+        return "collisions";
+    case PHASE_MISSILES:
+        return "missiles";
+    case PHASE_DRAW:
+        return "draw";
+    case PHASE_HUD:
+        return "hud";
+    case PHASE_DISPLAY:
+        return "display";
+    default:
+        return "unknown";
+    }
+}
+
+ScopedPhaseTimer::ScopedPhaseTimer(FrameProfiler *profiler, FramePhase phase)
+    : profiler(profiler), phase(phase), start(std::chrono::steady_clock::now())
+{
+}
+
+ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+    if (profiler != nullptr)
+    {
+        std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        profiler->addTime(phase, elapsed.count());
+    }
+}
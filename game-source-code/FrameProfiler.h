@@ -0,0 +1,156 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * @enum FramePhase
+ * @brief The parts of a frame that are timed separately.
+ */
+enum FramePhase
+{
+    PHASE_EVENTS,     /**< Polling window events. */
+    PHASE_BACKGROUND, /**< Scrolling and drawing the background. */
+    PHASE_MINIMAP,    /**< Rendering the minimap into its texture. */
+    PHASE_LANDERS,    /**< Lander updates and their collisions with the player and humanoids. */
+    PHASE_COLLISIONS, /**< The laser against humanoid and laser against lander loops. */
+    PHASE_MISSILES,   /**< Moving the lasers and missiles and checking missiles against the player. */
+    PHASE_DRAW,       /**< Drawing the player, lasers, landers, missiles and humanoids. */
+    PHASE_HUD,        /**< Updating and drawing the scoreboard and overlay text. */
+    PHASE_DISPLAY,    /**< window.display(), which includes waiting for vsync. */
+    NUM_FRAME_PHASES
+};
+
+const std::size_t FRAME_HISTORY_SIZE = 240; // the number of frames kept, 4 seconds at 60 fps
+
+/**
+ * @class FrameProfiler
+ * @brief Keeps how long each phase of the last FRAME_HISTORY_SIZE frames took.
+ *
+ * Timers add to the current frame until endFrame() stores it in a fixed-size ring buffer, so
+ * phases that run several times per frame, like the simulation steps, are summed. Use the
+ * PROFILE_PHASE macro rather than ScopedPhaseTimer directly: it compiles to nothing unless
+ * FRAME_PROFILER is defined.
+ */
+class FrameProfiler
+{
+public:
+    /**
+     * @brief The time in milliseconds of each phase of one frame.
+     */
+    typedef std::array<float, NUM_FRAME_PHASES> FrameSample;
+
+    /**
+     * @brief Construct a new FrameProfiler object with no frames recorded.
+     */
+    FrameProfiler();
+
+    /**
+     * @brief Add time to a phase of the current frame.
+     *
+     * @param phase The phase that ran.
+     * @param milliseconds How long it took.
+     */
+    void addTime(FramePhase phase, float milliseconds);
+
+    /**
+     * @brief Store the current frame in the history and start a new one.
+     */
+    void endFrame();
+
+    /**
+     * @brief Get the number of frames in the history.
+     *
+     * @return The number of frames, at most FRAME_HISTORY_SIZE.
+     */
+    std::size_t getNumFrames() const;
+
+    /**
+     * @brief Get a frame from the history.
+     *
+     * @param age 0 for the most recent finished frame, 1 for the one before, and so on.
+     * @return The phase times of that frame.
+     */
+    const FrameSample &getFrame(std::size_t age) const;
+
+    /**
+     * @brief Get the average time of a phase over the history.
+     *
+     * @param phase The phase to average.
+     * @return The average in milliseconds, or 0 if no frames were recorded.
+     */
+    float getAverage(FramePhase phase) const;
+
+    /**
+     * @brief Get the longest time of a phase over the history.
+     *
+     * @param phase The phase to check.
+     * @return The longest time in milliseconds, or 0 if no frames were recorded.
+     */
+    float getMax(FramePhase phase) const;
+
+    /**
+     * @brief Write the history to a CSV file, oldest frame first.
+     *
+     * @param filename The name of the file to write.
+     * @return True if the file was written, false otherwise.
+     */
+    bool saveToCsv(const std::string &filename) const;
+
+    /**
+     * @brief Get the name of a phase for the overlay and the CSV header.
+     *
+     * @param phase The phase.
+     * @return The phase's name.
+     */
+    static const char *getPhaseName(FramePhase phase);
+
+private:
+    std::array<FrameSample, FRAME_HISTORY_SIZE> history; /**< Ring buffer of finished frames. */
+    FrameSample current;                                 /**< The frame being timed. */
+    std::size_t next;                                    /**< Where the next finished frame goes. */
+    std::size_t numFrames;                               /**< How many slots of the history are filled. */
+};
+
+/**
+ * @class ScopedPhaseTimer
+ * @brief Times from its construction to the end of its scope and adds that to a phase.
+ */
+class ScopedPhaseTimer
+{
+public:
+    /**
+     * @brief Start timing a phase.
+     *
+     * @param profiler The profiler to add the time to, or nullptr to time nothing.
+     * @param phase The phase being timed.
+     */
+    ScopedPhaseTimer(FrameProfiler *profiler, FramePhase phase);
+
+    /**
+     * @brief Stop timing and add the time to the phase.
+     */
+    ~ScopedPhaseTimer();
+
+    ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+    ScopedPhaseTimer &operator=(const ScopedPhaseTimer &) = delete;
+
+private:
+    FrameProfiler *profiler;
+    FramePhase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef FRAME_PROFILER
+// times the rest of the enclosing scope as the given phase
+#define PROFILE_PHASE(profiler, phase) ScopedPhaseTimer PROFILE_CONCAT(phaseTimer, __LINE__)((profiler), (phase))
+#else
+#define PROFILE_PHASE(profiler, phase)
+#endif
+
+#endif
@@ -1,6 +1,7 @@
 
 #include "HighScore.h"
 #include "game.h"
+#include "ResourceCache.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -75,12 +76,7 @@ void HighScore::addHighScore(const std::string &name, int score)
 
 void HighScore::displayHighScores(sf::RenderWindow &window)
 {
-    sf::Font font;
-    if (!font.loadFromFile("resources/INVASION2000.ttf"))
-    {
-        std::cerr << "Failed to load font file" << std::endl;
-        return;
-    }
+    const sf::Font &font = getResourceCache().getFont("resources/INVASION2000.ttf");
 
     // Display the high scores on the window
     sf::Text highScoresText("High Scores:", font, 30);
@@ -0,0 +1,102 @@
+#include "HumanoidSystem.h"
+#include "CollisionSystem.h"
+#include "Simulation.h"
+
+const float FALLING_SPEED = 120.0f; // pixels per second
+const float WALKING_SPEED = 60.0f;  // pixels per second
+const float CARRIED_AWAY_HEIGHT = 60.0f; // a lander that carries a humanoid this high kills it
+
+Entity createHumanoid(Registry &registry, const sf::Vector2f &position, const sf::Sprite &sprite, const PixelMask *mask)
+{
+    Entity humanoid = registry.create();
+    registry.transforms.add(humanoid, {position, position});
+    registry.velocities.add(humanoid, {sf::Vector2f(WALKING_SPEED, 0.0f)});
+    registry.humanoids.add(humanoid, HumanoidAI());
+
+    sf::Sprite placed = sprite;
+    placed.setPosition(0, 0);
+    sf::FloatRect bounds = placed.getGlobalBounds();
+    registry.colliders.add(humanoid, {sf::Vector2f(bounds.left, bounds.top), sf::Vector2f(bounds.width, bounds.height), mask});
+    registry.bounds.add(humanoid, Bounds());
+    updateBounds(registry, humanoid);
+
+    Renderable renderable;
+    renderable.sprite = &sprite;
+    registry.renderables.add(humanoid, renderable);
+    return humanoid;
+}
+
+void updateHumanoid(Registry &registry, Entity humanoid, int &numHumanoids, float deltaTime)
+{
+    HumanoidAI &ai = registry.humanoids.get(humanoid);
+    sf::Vector2f &position = registry.transforms.get(humanoid).position;
+
+    if (ai.captured)
+    {
+        position = ai.capturedPosition;
+        if (ai.capturedPosition.y <= CARRIED_AWAY_HEIGHT && !ai.destroyed && !ai.playerCaptured)
+        {
+            destroyHumanoid(registry, humanoid);
+            numHumanoids--;
+        }
+    }
+    else if (ai.falling)
+    {
+        position.y += FALLING_SPEED * deltaTime;
+        if (position.y >= WINDOW_HEIGHT)
+        {
+            destroyHumanoid(registry, humanoid);
+            numHumanoids--;
+        }
+    }
+    else
+    {
+        sf::Vector2f &velocity = registry.velocities.get(humanoid).value;
+        position += velocity * deltaTime;
+
+        // this turns the humanoid around at the edges of the screen
+        if (position.x < 50 || position.x > WINDOW_WIDTH - 50)
+        {
+            velocity.x *= -1.0f;
+        }
+    }
+}
+
+void updateHumanoids(Registry &registry, int &numHumanoids, float deltaTime)
+{
+    for (std::size_t i = 0; i < registry.humanoids.size(); i++)
+    {
+        updateHumanoid(registry, registry.humanoids.getEntity(i), numHumanoids, deltaTime);
+    }
+}
+
+void captureHumanoid(Registry &registry, Entity humanoid, const sf::Vector2f &capturePosition)
+{
+    HumanoidAI &ai = registry.humanoids.get(humanoid);
+    ai.captured = true;
+    ai.falling = false;
+    ai.capturedPosition = capturePosition;
+}
+
+void releaseHumanoid(Registry &registry, Entity humanoid)
+{
+    HumanoidAI &ai = registry.humanoids.get(humanoid);
+    ai.captured = false;
+    ai.falling = true;
+}
+
+void depositHumanoid(Registry &registry, Entity humanoid, float x)
+{
+    HumanoidAI &ai = registry.humanoids.get(humanoid);
+    ai.captured = false;
+    ai.falling = false;
+    registry.transforms.get(humanoid).position = sf::Vector2f(x + 50, WINDOW_HEIGHT - 100);
+    updateBounds(registry, humanoid);
+}
+
+void destroyHumanoid(Registry &registry, Entity humanoid)
+{
+    registry.humanoids.get(humanoid).destroyed = true;
+    registry.renderables.remove(humanoid);
+    registry.queueDestroy(humanoid);
+}
@@ -0,0 +1,74 @@
+#ifndef HUMANOIDSYSTEM_H
+#define HUMANOIDSYSTEM_H
+#include <SFML/Graphics.hpp>
+#include "Registry.h"
+
+/**
+ * @brief Make a humanoid walking to the right.
+ *
+ * @param registry The registry to add the humanoid to.
+ * @param position The top left corner of the humanoid.
+ * @param sprite The sprite every humanoid is drawn with; its scale sets the humanoid's bounding box.
+ * @param mask The sprite's solid pixels, or nullptr to collide with the whole bounding box.
+ * @return The new humanoid.
+ */
+Entity createHumanoid(Registry &registry, const sf::Vector2f &position, const sf::Sprite &sprite, const PixelMask *mask = nullptr);
+
+/**
+ * @brief Move one humanoid: walking, falling, or carried by a lander or the player.
+ *
+ * A humanoid dies when it falls off the bottom of the screen or is carried to the top by a lander.
+ *
+ * @param registry The registry that holds the humanoid.
+ * @param humanoid The humanoid.
+ * @param numHumanoids The number of living humanoids, lowered when this one dies.
+ * @param deltaTime The time passed since the last update, in seconds.
+ */
+void updateHumanoid(Registry &registry, Entity humanoid, int &numHumanoids, float deltaTime);
+
+/**
+ * @brief Move every humanoid.
+ *
+ * @param registry The registry that holds the humanoids.
+ * @param numHumanoids The number of living humanoids, lowered for each one that dies.
+ * @param deltaTime The time passed since the last update, in seconds.
+ */
+void updateHumanoids(Registry &registry, int &numHumanoids, float deltaTime);
+
+/**
+ * @brief Have a lander or the player pick a humanoid up; it follows the carrier from the next update.
+ *
+ * @param registry The registry that holds the humanoid.
+ * @param humanoid The humanoid.
+ * @param capturePosition Where the carrier is.
+ */
+void captureHumanoid(Registry &registry, Entity humanoid, const sf::Vector2f &capturePosition);
+
+/**
+ * @brief Drop a carried humanoid so it falls.
+ *
+ * @param registry The registry that holds the humanoid.
+ * @param humanoid The humanoid.
+ */
+void releaseHumanoid(Registry &registry, Entity humanoid);
+
+/**
+ * @brief Put a carried humanoid down on the ground.
+ *
+ * @param registry The registry that holds the humanoid.
+ * @param humanoid The humanoid.
+ * @param x Where the carrier is along the ground.
+ */
+void depositHumanoid(Registry &registry, Entity humanoid, float x);
+
+/**
+ * @brief Mark a humanoid as dead and hide it.
+ *
+ * The humanoid stays in the registry until the next Registry::flushDestroyed().
+ *
+ * @param registry The registry that holds the humanoid.
+ * @param humanoid The humanoid.
+ */
+void destroyHumanoid(Registry &registry, Entity humanoid);
+
+#endif
@@ -0,0 +1,174 @@
+#include "InputRecording.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+// file layout: magic, version, seed, lander cap, humanoid cap, number of updates, then one
+// (controls byte, variable-length count) pair per run of updates with the same controls
+const char RECORDING_MAGIC[4] = {'D', 'F', 'R', 'C'};
+const std::uint8_t RECORDING_VERSION = 1;
+
+static void writeUint(std::ostream &out, std::uint64_t value, int numBytes)
+{
+    for (int i = 0; i < numBytes; i++)
+    {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static bool readUint(std::istream &in, std::uint64_t &value, int numBytes)
+{
+    value = 0;
+    for (int i = 0; i < numBytes; i++)
+    {
+        int byte = in.get();
+        if (byte == EOF)
+        {
+            return false;
+        }
+        value |= static_cast<std::uint64_t>(byte) << (8 * i);
+    }
+    return true;
+}
+
+// counts are written 7 bits at a time, with the top bit set on every byte but the last
+static void writeCount(std::ostream &out, std::uint64_t count)
+{
+    while (count >= 0x80)
+    {
+        out.put(static_cast<char>((count & 0x7F) | 0x80));
+        count >>= 7;
+    }
+    out.put(static_cast<char>(count));
+}
+
+static bool readCount(std::istream &in, std::uint64_t &count)
+{
+    count = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        int byte = in.get();
+        if (byte == EOF)
+        {
+            return false;
+        }
+        count |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+InputRecording::InputRecording(const SimConfig &config) : config(config)
+{
+}
+
+void InputRecording::record(const InputState &input)
+{
+    ticks.push_back(pack(input));
+}
+
+InputState InputRecording::getInput(std::size_t tick) const
+{
+    return unpack(ticks[tick]);
+}
+
+std::size_t InputRecording::getNumTicks() const
+{
+    return ticks.size();
+}
+
+const SimConfig &InputRecording::getConfig() const
+{
+    return config;
+}
+
+bool InputRecording::saveToFile(const std::string &filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    writeUint(file, RECORDING_VERSION, 1);
+    writeUint(file, config.seed, 4);
+    writeUint(file, static_cast<std::uint32_t>(config.maxLanders), 4);
+    writeUint(file, static_cast<std::uint32_t>(config.maxHumanoids), 4);
+    writeUint(file, ticks.size(), 8);
+
+    std::size_t runStart = 0;
+    while (runStart < ticks.size())
+    {
+        std::size_t runEnd = runStart + 1;
+        while (runEnd < ticks.size() && ticks[runEnd] == ticks[runStart])
+        {
+            runEnd++;
+        }
+        file.put(static_cast<char>(ticks[runStart]));
+        writeCount(file, runEnd - runStart);
+        runStart = runEnd;
+    }
+    return file.good();
+}
+
+bool InputRecording::loadFromFile(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    char magic[sizeof(RECORDING_MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), RECORDING_MAGIC))
+    {
+        return false;
+    }
+
+    std::uint64_t version, seed, maxLanders, maxHumanoids, numTicks;
+    if (!readUint(file, version, 1) || version != RECORDING_VERSION || !readUint(file, seed, 4) ||
+        !readUint(file, maxLanders, 4) || !readUint(file, maxHumanoids, 4) || !readUint(file, numTicks, 8))
+    {
+        return false;
+    }
+
+    std::vector<std::uint8_t> loadedTicks;
+    while (loadedTicks.size() < numTicks)
+    {
+        int bits = file.get();
+        std::uint64_t count;
+        if (bits == EOF || !readCount(file, count) || count > numTicks - loadedTicks.size())
+        {
+            return false;
+        }
+        loadedTicks.insert(loadedTicks.end(), count, static_cast<std::uint8_t>(bits));
+    }
+
+    config.seed = static_cast<unsigned int>(seed);
+    config.maxLanders = static_cast<int>(maxLanders);
+    config.maxHumanoids = static_cast<int>(maxHumanoids);
+    ticks.swap(loadedTicks);
+    return true;
+}
+
+std::uint8_t InputRecording::pack(const InputState &input)
+{
+    return static_cast<std::uint8_t>(input.up | input.down << 1 | input.left << 2 | input.right << 3 |
+                                     input.fire << 4 | input.shield << 5);
+}
+
+InputState InputRecording::unpack(std::uint8_t bits)
+{
+    InputState input;
+    input.up = bits & 1;
+    input.down = bits & 2;
+    input.left = bits & 4;
+    input.right = bits & 8;
+    input.fire = bits & 16;
+    input.shield = bits & 32;
+    return input;
+}
@@ -0,0 +1,94 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "InputState.h"
+#include "Simulation.h"
+
+/**
+ * @class InputRecording
+ * @brief The controls of a whole game, one InputState per simulation update, plus the settings it was played with.
+ *
+ * The simulation only depends on its SimConfig and the input of each update, so feeding a
+ * recording back into a new Simulation plays the same game again, as fast as the CPU allows.
+ * In memory each update takes one byte. On disk, runs of updates with the same controls are
+ * stored once with a count, so a typical session needs a few bytes per second of play.
+ */
+class InputRecording
+{
+public:
+    /**
+     * @brief Construct a new, empty InputRecording object.
+     *
+     * @param config The settings of the simulation being recorded.
+     */
+    explicit InputRecording(const SimConfig &config = SimConfig());
+
+    /**
+     * @brief Add the controls of the next simulation update.
+     *
+     * @param input The controls passed to the update.
+     */
+    void record(const InputState &input);
+
+    /**
+     * @brief Get the controls of a recorded update.
+     *
+     * @param tick The number of the update, starting at 0.
+     * @return The controls passed to that update.
+     */
+    InputState getInput(std::size_t tick) const;
+
+    /**
+     * @brief Get the number of recorded updates.
+     *
+     * @return The number of updates.
+     */
+    std::size_t getNumTicks() const;
+
+    /**
+     * @brief Get the settings the recorded simulation was started with.
+     *
+     * @return The simulation settings.
+     */
+    const SimConfig &getConfig() const;
+
+    /**
+     * @brief Save the recording to a file.
+     *
+     * @param filename The name of the file to write.
+     * @return True if the file was written, false otherwise.
+     */
+    bool saveToFile(const std::string &filename) const;
+
+    /**
+     * @brief Load a recording from a file, replacing this one.
+     *
+     * @param filename The name of the file to read.
+     * @return True if the file was a valid recording, false otherwise.
+     */
+    bool loadFromFile(const std::string &filename);
+
+    /**
+     * @brief Pack the controls into one byte, one bit per control.
+     *
+     * @param input The controls to pack.
+     * @return The packed controls.
+     */
+    static std::uint8_t pack(const InputState &input);
+
+    /**
+     * @brief Unpack controls packed by pack().
+     *
+     * @param bits The packed controls.
+     * @return The controls.
+     */
+    static InputState unpack(std::uint8_t bits);
+
+private:
+    SimConfig config;              /**< The settings the simulation was started with. */
+    std::vector<std::uint8_t> ticks; /**< The packed controls of every update. */
+};
+
+#endif
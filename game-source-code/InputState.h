@@ -0,0 +1,21 @@
+#ifndef INPUTSTATE_H
+#define INPUTSTATE_H
+
+/**
+ * @struct InputState
+ * @brief The player's controls for a single simulation update.
+ *
+ * The Game fills this in from the keyboard and the headless runner fills it in from a script,
+ * so the simulation never has to ask SFML which keys are held down.
+ */
+struct InputState
+{
+    bool up = false;     /**< Move the ship up. */
+    bool down = false;   /**< Move the ship down. */
+    bool left = false;   /**< Move the ship left. */
+    bool right = false;  /**< Move the ship right. */
+    bool fire = false;   /**< Fire a laser, or start the game from the splash screen. */
+    bool shield = false; /**< Raise the shield. */
+};
+
+#endif
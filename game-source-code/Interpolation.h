@@ -0,0 +1,36 @@
+#ifndef INTERPOLATION_H
+#define INTERPOLATION_H
+#include <SFML/Graphics.hpp>
+
+/**
+ * @brief Blend between an entity's position at the last two simulation updates.
+ *
+ * The simulation runs at a fixed rate that does not match the display, so each frame is drawn
+ * part of the way between the previous update and the latest one.
+ *
+ * @param previous The position after the update before last.
+ * @param current The position after the last update.
+ * @param alpha How far the frame is between the two updates, from 0 (previous) to 1 (current).
+ * @return The position to draw at.
+ */
+inline sf::Vector2f interpolate(const sf::Vector2f &previous, const sf::Vector2f &current, float alpha)
+{
+    return previous + (current - previous) * alpha;
+}
+
+/**
+ * @brief Build render states that draw an entity at its interpolated position.
+ *
+ * @param previous The position after the update before last.
+ * @param current The position after the last update.
+ * @param alpha How far the frame is between the two updates, from 0 (previous) to 1 (current).
+ * @return Render states translated from the current position to the interpolated one.
+ */
+inline sf::RenderStates interpolatedStates(const sf::Vector2f &previous, const sf::Vector2f &current, float alpha)
+{
+    sf::RenderStates states;
+    states.transform.translate(interpolate(previous, current, alpha) - current);
+    return states;
+}
+
+#endif
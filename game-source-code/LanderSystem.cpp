@@ -0,0 +1,329 @@
+#include "LanderSystem.h"
+#include "CollisionSystem.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+
+const float MOVEMENT_SPEED = 240.0f; // pixels per second
+const float APPROACH_SPEED = 80.0f;  // pixels per second when heading straight for a humanoid
+const float SEEK_DISTANCE = 1000.0f; // landers only go after humanoids nearer than this, along the axes
+const float SPAWN_HEIGHT = 50.0f;
+const std::size_t LANDERS_PER_THREAD = 256; // fewer landers than this are not worth handing to another thread
+
+const float SEPARATION_RADIUS = 100.0f;  // landers nearer than this push each other apart
+const float SEPARATION_WEIGHT = 6000.0f; // pixels squared per second; the push from a lander d pixels away is this / d
+const float ALIGNMENT_WEIGHT = 0.3f;     // share of the difference from the neighbours' average velocity steered per second
+const float COHESION_WEIGHT = 0.5f;      // per second, towards the neighbours' middle
+const float MAX_FLOCK_SPEED = 120.0f;    // pixels per second the flocking can add to a lander's own movement
+const int MAX_NEIGHBOURS = 16;           // neighbours counted per lander, which keeps a crowd linear
+
+const float LOD_NEAR_DISTANCE = 600.0f;           // landers further than this from the player, across, are far
+const std::size_t FAR_LANDERS_PER_UPDATE = 256;   // how many far landers may think in one update
+
+Entity createLander(Registry &registry, Random &random, const sf::Sprite &sprite, const PixelMask *mask)
+{
+    Entity lander = registry.create();
+    registry.transforms.add(lander, Transform());
+    registry.landers.add(lander, LanderAI());
+
+    // the sprite's bounds at the origin are the box relative to the lander's position
+    sf::Sprite placed = sprite;
+    placed.setPosition(0, 0);
+    sf::FloatRect bounds = placed.getGlobalBounds();
+    registry.colliders.add(lander, {sf::Vector2f(bounds.left, bounds.top), sf::Vector2f(bounds.width, bounds.height), mask});
+    registry.bounds.add(lander, Bounds());
+
+    Renderable renderable;
+    renderable.sprite = &sprite;
+    registry.renderables.add(lander, renderable);
+
+    spawnLander(registry, lander, random);
+    return lander;
+}
+
+void spawnLander(Registry &registry, Entity lander, Random &random)
+{
+    Transform &transform = registry.transforms.get(lander);
+    LanderAI &ai = registry.landers.get(lander);
+    float x, y;
+
+    // this keeps generating random positions until a valid one is found
+    do
+    {
+        x = static_cast<float>(random.nextInt(WINDOW_WIDTH));
+        y = SPAWN_HEIGHT;
+    } while (std::abs(x - ai.moveTarget.x) < 100 && std::abs(y - ai.moveTarget.y) < 100);
+
+    transform.position = sf::Vector2f(x, y);
+    transform.previousPosition = transform.position;
+
+    // this initialises moveTarget to a random position within a limited distance
+    float offsetX = static_cast<float>(random.nextInt(200) - 100);
+    float offsetY = static_cast<float>(random.nextInt(200) - 100);
+    ai.moveTarget = sf::Vector2f(x + offsetX, y + offsetY);
+    updateBounds(registry, lander);
+}
+
+void assignLanderTargets(Registry &registry, TargetIndex &humanoids, WorkerPool &workers)
+{
+    humanoids.clear();
+    for (std::size_t i = 0; i < registry.humanoids.size(); i++)
+    {
+        if (!registry.humanoids[i].destroyed)
+        {
+            humanoids.insert(static_cast<std::uint32_t>(i), registry.transforms.get(registry.humanoids.getEntity(i)).position);
+        }
+    }
+    humanoids.build();
+    if (humanoids.size() == 0)
+    {
+        return;
+    }
+
+    // this shares the seeking landers out as evenly as the humanoids allow
+    std::size_t numSeeking = 0;
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        numSeeking += !registry.landers[i].destroyed && !registry.landers[i].captured;
+    }
+    std::size_t maxChasers = (numSeeking + humanoids.size() - 1) / humanoids.size();
+    std::vector<std::size_t> numChasers(registry.humanoids.size(), 0);
+    auto chase = [&](LanderAI &ai, std::size_t humanoid)
+    {
+        Entity entity = registry.humanoids.getEntity(humanoid);
+        ai.targetHumanoid = entity;
+        ai.moveTarget = registry.transforms.get(entity).position;
+        if (++numChasers[humanoid] == maxChasers)
+        {
+            humanoids.remove(static_cast<std::uint32_t>(humanoid), ai.moveTarget);
+        }
+    };
+
+    // a lander that does not think this update keeps chasing the humanoid it had, wherever it has walked to
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        LanderAI &ai = registry.landers[i];
+        if (!ai.thinking && !ai.destroyed && !ai.captured && registry.humanoids.has(ai.targetHumanoid) &&
+            !registry.humanoids.get(ai.targetHumanoid).destroyed)
+        {
+            chase(ai, registry.humanoids.getIndex(ai.targetHumanoid));
+        }
+    }
+
+    // the searches only read, so every thinking lander looks for its nearest humanoid at once
+    std::vector<std::uint32_t> nearest(registry.landers.size(), NO_TARGET);
+    workers.run(registry.landers.size(), LANDERS_PER_THREAD, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        const LanderAI &ai = registry.landers[i];
+                        if (ai.thinking && !ai.destroyed && !ai.captured)
+                        {
+                            const sf::Vector2f &position = registry.transforms.get(registry.landers.getEntity(i)).position;
+                            nearest[i] = humanoids.findNearest(position, SEEK_DISTANCE);
+                        }
+                    }
+                });
+
+    // this hands out the humanoids in pool order, so the result is the same for any number of threads;
+    // only a lander whose nearest humanoid filled up before its turn has to search again
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        LanderAI &ai = registry.landers[i];
+        std::uint32_t target = nearest[i];
+        if (target != NO_TARGET && numChasers[target] >= maxChasers)
+        {
+            const sf::Vector2f &position = registry.transforms.get(registry.landers.getEntity(i)).position;
+            target = humanoids.findNearest(position, SEEK_DISTANCE);
+        }
+        // a lander with no humanoid in reach keeps heading where it was
+        if (target != NO_TARGET)
+        {
+            chase(ai, target);
+        }
+        else if (ai.thinking)
+        {
+            ai.targetHumanoid = NO_ENTITY;
+        }
+    }
+}
+
+void sliceLanderAI(Registry &registry, float playerX, std::uint64_t update)
+{
+    std::size_t numFar = 0;
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        numFar += std::abs(registry.transforms.get(registry.landers.getEntity(i)).position.x - playerX) > LOD_NEAR_DISTANCE;
+    }
+
+    // the far landers take turns, so no more than FAR_LANDERS_PER_UPDATE of them think at once
+    std::size_t numSlices = std::max<std::size_t>(1, (numFar + FAR_LANDERS_PER_UPDATE - 1) / FAR_LANDERS_PER_UPDATE);
+    std::size_t farIndex = 0;
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        bool far = std::abs(registry.transforms.get(registry.landers.getEntity(i)).position.x - playerX) > LOD_NEAR_DISTANCE;
+        registry.landers[i].thinking = !far || (farIndex++ + update) % numSlices == 0;
+    }
+}
+
+// heads for the lander's target humanoid, or down to the ground if it has none
+static void seekHumanoid(sf::Vector2f &position, LanderAI &ai, float deltaTime)
+{
+    // this calculates the direction to move towards the moveTarget
+    sf::Vector2f direction = ai.moveTarget - position;
+    float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    direction /= distance;
+    sf::Vector2f newPosition = position + direction * APPROACH_SPEED * deltaTime;
+
+    if (newPosition.x > 0 && newPosition.x < WINDOW_WIDTH && newPosition.y > 0 && newPosition.y < WINDOW_HEIGHT && ai.moveTarget.y == (WINDOW_HEIGHT - 100))
+    {
+        position = newPosition;
+    }
+    else if (newPosition.y < WINDOW_HEIGHT - 110)
+    {
+        position.y += MOVEMENT_SPEED * deltaTime;
+    }
+    else if (newPosition.x < WINDOW_WIDTH - 50)
+    {
+        position.x += MOVEMENT_SPEED * deltaTime;
+    }
+    else if (newPosition.x > 50)
+    {
+        position.x -= MOVEMENT_SPEED * deltaTime;
+    }
+}
+
+void updateLanders(Registry &registry, float deltaTime, WorkerPool &workers)
+{
+    // each lander only writes its own position and AI, so the landers are shared out between the threads as they are
+    workers.run(registry.landers.size(), LANDERS_PER_THREAD, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        LanderAI &ai = registry.landers[i];
+                        if (ai.destroyed)
+                        {
+                            ai.captured = false;
+                            continue;
+                        }
+
+                        sf::Vector2f &position = registry.transforms.get(registry.landers.getEntity(i)).position;
+                        if (!ai.captured)
+                        {
+                            seekHumanoid(position, ai, deltaTime);
+                        }
+                        else if (position.y >= SPAWN_HEIGHT)
+                        {
+                            position.y -= MOVEMENT_SPEED * deltaTime; // carry the humanoid up
+                        }
+                        else
+                        {
+                            ai.captured = false;
+                        }
+                    }
+                });
+}
+
+// works out one lander's flocking from the neighbours the grid finds around it
+static sf::Vector2f getFlockSteering(std::uint32_t lander, const sf::Vector2f &position, const std::vector<sf::Vector2f> &velocities,
+                                     const SpatialGrid &neighbours)
+{
+    sf::Vector2f separation, totalPosition, totalVelocity;
+    int numNeighbours = 0;
+    sf::FloatRect reach(position.x - FLOCK_RADIUS, position.y - FLOCK_RADIUS, 2 * FLOCK_RADIUS, 2 * FLOCK_RADIUS);
+    neighbours.forEachInCells(reach, [&](std::uint32_t other, const sf::Vector2f &otherPosition)
+                              {
+                                  sf::Vector2f away = position - otherPosition;
+                                  float distanceSquared = away.x * away.x + away.y * away.y;
+                                  if (other == lander || distanceSquared >= FLOCK_RADIUS * FLOCK_RADIUS)
+                                  {
+                                      return true;
+                                  }
+                                  if (distanceSquared == 0.0f)
+                                  {
+                                      // landers stacked exactly on top of each other split sideways, by pool order
+                                      away = sf::Vector2f(lander < other ? -1.0f : 1.0f, 0.0f);
+                                      distanceSquared = 1.0f;
+                                  }
+                                  if (distanceSquared < SEPARATION_RADIUS * SEPARATION_RADIUS)
+                                  {
+                                      separation += away / distanceSquared;
+                                  }
+                                  totalPosition += otherPosition;
+                                  totalVelocity += velocities[other];
+                                  return ++numNeighbours < MAX_NEIGHBOURS;
+                              });
+    if (numNeighbours == 0)
+    {
+        return sf::Vector2f();
+    }
+
+    sf::Vector2f steering = separation * SEPARATION_WEIGHT +
+                            (totalVelocity / static_cast<float>(numNeighbours) - velocities[lander]) * ALIGNMENT_WEIGHT +
+                            (totalPosition / static_cast<float>(numNeighbours) - position) * COHESION_WEIGHT;
+    float speed = std::sqrt(steering.x * steering.x + steering.y * steering.y);
+    if (speed > MAX_FLOCK_SPEED)
+    {
+        steering *= MAX_FLOCK_SPEED / speed;
+    }
+    return steering;
+}
+
+void flockLanders(Registry &registry, SpatialGrid &neighbours, float deltaTime, WorkerPool &workers)
+{
+    if (deltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    // this records where every living lander is and how fast it moved this update
+    std::size_t numLanders = registry.landers.size();
+    std::vector<sf::Vector2f> velocities(numLanders);
+    neighbours.clear();
+    for (std::size_t i = 0; i < numLanders; i++)
+    {
+        if (!registry.landers[i].destroyed)
+        {
+            const Transform &transform = registry.transforms.get(registry.landers.getEntity(i));
+            velocities[i] = (transform.position - transform.previousPosition) / deltaTime;
+            neighbours.insert(static_cast<std::uint32_t>(i), sf::FloatRect(transform.position, sf::Vector2f()));
+        }
+    }
+    neighbours.build();
+
+    // the steering is only read from positions, so every thinking lander's is worked out before any of them moves;
+    // the others keep the steering they had
+    workers.run(numLanders, LANDERS_PER_THREAD, [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        LanderAI &ai = registry.landers[i];
+                        if (ai.thinking && !ai.destroyed && !ai.captured)
+                        {
+                            const sf::Vector2f &position = registry.transforms.get(registry.landers.getEntity(i)).position;
+                            ai.steering = getFlockSteering(static_cast<std::uint32_t>(i), position, velocities, neighbours);
+                        }
+                    }
+                });
+
+    for (std::size_t i = 0; i < numLanders; i++)
+    {
+        const LanderAI &ai = registry.landers[i];
+        if (!ai.destroyed && !ai.captured && ai.steering != sf::Vector2f())
+        {
+            sf::Vector2f &position = registry.transforms.get(registry.landers.getEntity(i)).position;
+            position += ai.steering * deltaTime;
+            position.x = std::min(std::max(position.x, 0.0f), static_cast<float>(WINDOW_WIDTH));
+            position.y = std::min(std::max(position.y, 0.0f), static_cast<float>(WINDOW_HEIGHT));
+        }
+    }
+}
+
+void destroyLander(Registry &registry, Entity lander)
+{
+    registry.landers.get(lander).destroyed = true;
+    registry.transforms.get(lander).position = sf::Vector2f(-50, -50);
+    updateBounds(registry, lander);
+    registry.renderables.remove(lander);
+    registry.queueDestroy(lander);
+}
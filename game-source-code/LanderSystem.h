@@ -0,0 +1,99 @@
+#ifndef LANDERSYSTEM_H
+#define LANDERSYSTEM_H
+#include <SFML/Graphics.hpp>
+#include "Registry.h"
+#include "Random.h"
+#include "SpatialGrid.h"
+#include "TargetIndex.h"
+#include "WorkerPool.h"
+
+const float FLOCK_RADIUS = 160.0f; // landers nearer than this steer together; also the flocking grid's cell size
+
+/**
+ * @brief Make a lander at a random place near the top of the screen.
+ *
+ * @param registry The registry to add the lander to.
+ * @param random The lander's random stream, used to pick where it spawns and heads first.
+ * @param sprite The sprite every lander is drawn with; its scale and origin set the lander's bounding box.
+ * @param mask The sprite's solid pixels, or nullptr to collide with the whole bounding box.
+ * @return The new lander.
+ */
+Entity createLander(Registry &registry, Random &random, const sf::Sprite &sprite, const PixelMask *mask = nullptr);
+
+/**
+ * @brief Move a lander to a new random place near the top of the screen.
+ *
+ * @param registry The registry that holds the lander.
+ * @param lander The lander.
+ * @param random The lander's random stream.
+ */
+void spawnLander(Registry &registry, Entity lander, Random &random);
+
+/**
+ * @brief Choose which landers think this update, that is search for a target and their neighbours.
+ *
+ * Landers near the player, whose choices show, think every update. Far ones take turns in pool
+ * order so that only a fixed number think per update however many there are, and in between they
+ * keep their last target and flocking. Every lander still moves every update, so each is exactly
+ * where it should be when the player comes close.
+ *
+ * @param registry The registry that holds the landers.
+ * @param playerX Where the player is across the world.
+ * @param update The number of the update, which picks whose turn it is.
+ */
+void sliceLanderAI(Registry &registry, float playerX, std::uint64_t update);
+
+/**
+ * @brief Give every lander that is looking for a humanoid the nearest one as its target, once per update.
+ *
+ * Landers are assigned in pool order, and once a humanoid has its share of the seeking landers
+ * the next ones go for their nearest humanoid that still has room, so they spread out instead of
+ * all crowding one. The searches run on the worker threads and the humanoids are then handed out
+ * on the caller's, so the targets are the same for any number of threads. A lander that is not
+ * thinking this update skips the search and keeps chasing its humanoid, and still counts towards
+ * that humanoid's share.
+ *
+ * @param registry The registry that holds the landers and humanoids.
+ * @param humanoids Rebuilt with the living humanoids, by their place in the humanoid pool. Humanoids
+ * with their share of landers are removed from it as the landers are assigned.
+ * @param workers The threads that search.
+ */
+void assignLanderTargets(Registry &registry, TargetIndex &humanoids, WorkerPool &workers);
+
+/**
+ * @brief Move every lander: towards its target humanoid, down to the ground, or up while carrying one.
+ *
+ * @param registry The registry that holds the landers and humanoids.
+ * @param deltaTime The time passed since the last update, in seconds.
+ * @param workers The threads that share out the landers.
+ */
+void updateLanders(Registry &registry, float deltaTime, WorkerPool &workers);
+
+/**
+ * @brief Steer the landers that are looking for a humanoid as a flock, after they have moved.
+ *
+ * Each one is pushed away from landers too close to it (separation), towards how its neighbours
+ * are moving (alignment) and towards their middle (cohesion), so landers chasing the same
+ * humanoid spread around it instead of stacking. Neighbours come from a grid with cells one
+ * FLOCK_RADIUS across and only the first few found are counted, so a crowd costs the same per
+ * lander as a sparse wave. The steering is worked out for every thinking lander before any of
+ * them moves, so it is the same for any number of threads; the others keep theirs.
+ *
+ * @param registry The registry that holds the landers.
+ * @param neighbours Rebuilt with the living landers, by their place in the lander pool.
+ * @param deltaTime The time passed since the last update, in seconds.
+ * @param workers The threads that share out the landers.
+ */
+void flockLanders(Registry &registry, SpatialGrid &neighbours, float deltaTime, WorkerPool &workers);
+
+/**
+ * @brief Mark a lander as destroyed, hide it and move it off the screen.
+ *
+ * The lander stays in the registry until the next Registry::flushDestroyed().
+ *
+ * @param registry The registry that holds the lander.
+ * @param lander The lander.
+ */
+void destroyLander(Registry &registry, Entity lander);
+
+#endif
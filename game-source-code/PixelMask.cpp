@@ -0,0 +1,134 @@
+#include "PixelMask.h"
+#include <algorithm>
+
+const sf::Uint8 SOLID_ALPHA = 128; // pixels more opaque than this are solid
+
+PixelMask::PixelMask() : width(0), height(0), wordsPerRow(0)
+{
+}
+
+PixelMask::PixelMask(const sf::Image &image, const sf::Vector2u &size, bool mirrored)
+    : width(static_cast<int>(size.x)), height(static_cast<int>(size.y)), wordsPerRow((width + 63) / 64),
+      bits(static_cast<std::size_t>(wordsPerRow) * height, 0)
+{
+    sf::Vector2u imageSize = image.getSize();
+    if (imageSize.x == 0 || imageSize.y == 0)
+    {
+        return;
+    }
+
+    for (int y = 0; y < height; y++)
+    {
+        // this is the block of image rows and columns the mask pixel covers, at least one of each
+        unsigned top = y * imageSize.y / height;
+        unsigned bottom = std::max(top + 1, (y + 1) * imageSize.y / height);
+        for (int x = 0; x < width; x++)
+        {
+            unsigned left = x * imageSize.x / width;
+            unsigned right = std::max(left + 1, (x + 1) * imageSize.x / width);
+            bool solid = false;
+            for (unsigned row = top; row < bottom && !solid; row++)
+            {
+                for (unsigned column = left; column < right && !solid; column++)
+                {
+                    solid = image.getPixel(column, row).a > SOLID_ALPHA;
+                }
+            }
+            if (solid)
+            {
+                int maskX = mirrored ? width - 1 - x : x;
+                bits[y * wordsPerRow + maskX / 64] |= std::uint64_t(1) << (maskX % 64);
+            }
+        }
+    }
+}
+
+bool PixelMask::overlaps(const PixelMask &other, const sf::Vector2i &offset) const
+{
+    int top = std::max(0, offset.y);
+    int bottom = std::min(height, offset.y + other.height);
+    int left = std::max(0, offset.x);
+    int right = std::min(width, offset.x + other.width);
+    if (left >= right)
+    {
+        return false;
+    }
+
+    // the other mask's pixels outside it read as clear, so whole words of this one can be compared
+    for (int y = top; y < bottom; y++)
+    {
+        for (int word = left / 64; word <= (right - 1) / 64; word++)
+        {
+            if (bits[y * wordsPerRow + word] & other.getBits(y - offset.y, word * 64 - offset.x))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool PixelMask::overlaps(const sf::IntRect &rect) const
+{
+    int top = std::max(0, rect.top);
+    int bottom = std::min(height, rect.top + rect.height);
+    int left = std::max(0, rect.left);
+    int right = std::min(width, rect.left + rect.width);
+    if (left >= right)
+    {
+        return false;
+    }
+
+    for (int y = top; y < bottom; y++)
+    {
+        for (int word = left / 64; word <= (right - 1) / 64; word++)
+        {
+            // this keeps only the columns of the word inside the rectangle
+            int first = std::max(left - word * 64, 0);
+            int last = std::min(right - word * 64, 64);
+            std::uint64_t columns = (last == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << last) - 1) & (~std::uint64_t(0) << first);
+            if (bits[y * wordsPerRow + word] & columns)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool PixelMask::isSolid(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+    {
+        return false;
+    }
+    return (bits[y * wordsPerRow + x / 64] >> (x % 64)) & 1;
+}
+
+sf::Vector2u PixelMask::getSize() const
+{
+    return sf::Vector2u(width, height);
+}
+
+std::uint64_t PixelMask::getBits(int y, int x) const
+{
+    if (y < 0 || y >= height)
+    {
+        return 0;
+    }
+    // floor division, so columns left of the mask fall in word -1
+    int word = x >= 0 ? x / 64 : (x - 63) / 64;
+    int shift = x - word * 64;
+    const std::uint64_t *row = &bits[y * wordsPerRow];
+
+    std::uint64_t result = 0;
+    if (word >= 0 && word < wordsPerRow)
+    {
+        result = row[word] >> shift;
+    }
+    if (shift != 0 && word + 1 >= 0 && word + 1 < wordsPerRow)
+    {
+        result |= row[word + 1] << (64 - shift);
+    }
+    return result;
+}
@@ -0,0 +1,90 @@
+#ifndef PIXELMASK_H
+#define PIXELMASK_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class PixelMask
+ * @brief Which pixels of a sprite are solid, one bit each, at the size the sprite is drawn.
+ *
+ * Each row is packed into 64 bit words, so testing two masks against each other ANDs 64 pixels
+ * at a time instead of reading them one by one. Masks are built once per image and size, and
+ * only tested after the bounding boxes are already known to overlap.
+ */
+class PixelMask
+{
+public:
+    /**
+     * @brief Construct a new, empty PixelMask object, with no solid pixels.
+     */
+    PixelMask();
+
+    /**
+     * @brief Construct a new PixelMask object from an image's alpha channel, scaled to a size.
+     *
+     * A pixel of the mask is solid if any image pixel it covers is more than half opaque.
+     *
+     * @param image The image.
+     * @param size The width and height of the mask in pixels, usually the sprite's drawn size.
+     * @param mirrored Whether the image is flipped left to right, as a sprite with a negative x scale is drawn.
+     */
+    PixelMask(const sf::Image &image, const sf::Vector2u &size, bool mirrored = false);
+
+    /**
+     * @brief Check if another mask shares a solid pixel with this one.
+     *
+     * @param other The other mask.
+     * @param offset Where the other mask's top left pixel is, relative to this one's.
+     * @return True if a pixel is solid in both, false otherwise.
+     */
+    bool overlaps(const PixelMask &other, const sf::Vector2i &offset) const;
+
+    /**
+     * @brief Check if a rectangle covers a solid pixel.
+     *
+     * @param rect The rectangle, relative to the mask's top left pixel.
+     * @return True if a solid pixel is inside the rectangle, false otherwise.
+     */
+    bool overlaps(const sf::IntRect &rect) const;
+
+    /**
+     * @brief Check if a pixel is solid.
+     *
+     * @param x The pixel's column.
+     * @param y The pixel's row.
+     * @return True if the pixel is inside the mask and solid, false otherwise.
+     */
+    bool isSolid(int x, int y) const;
+
+    /**
+     * @brief Get the size of the mask.
+     *
+     * @return The width and height in pixels.
+     */
+    sf::Vector2u getSize() const;
+
+private:
+    /**
+     * @brief Get 64 pixels of a row starting at any column, with the ones outside the mask clear.
+     */
+    std::uint64_t getBits(int y, int x) const;
+
+    int width;
+    int height;
+    int wordsPerRow;
+    std::vector<std::uint64_t> bits; /**< Row by row, bit x % 64 of word x / 64 is column x. */
+};
+
+/**
+ * @brief Get the size of the mask that fits a bounding box, to the nearest pixel.
+ *
+ * @param bounds The bounding box, usually a sprite's global bounds.
+ * @return The width and height in pixels.
+ */
+inline sf::Vector2u getMaskSize(const sf::FloatRect &bounds)
+{
+    return sf::Vector2u(static_cast<unsigned>(bounds.width + 0.5f), static_cast<unsigned>(bounds.height + 0.5f));
+}
+
+#endif
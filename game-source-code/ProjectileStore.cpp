@@ -0,0 +1,219 @@
+#include "ProjectileStore.h"
+#include "BatchIntersect.h"
+#include "CollisionSystem.h"
+#include <algorithm>
+#include <cmath>
+
+const float LASER_LIFETIME = 2.0f;    // seconds, long enough to cross the whole screen
+const float MISSILE_LIFETIME = 12.0f; // seconds
+const sf::Vector2f LASER_SIZE(40.0f, 5.0f);
+const sf::Vector2f MISSILE_SIZE(20.0f, 10.0f);
+
+static const sf::Vector2f &sizeOf(ProjectileOwner owner)
+{
+    return owner == OWNER_PLAYER ? LASER_SIZE : MISSILE_SIZE;
+}
+
+ProjectileStore::ProjectileStore(const sf::FloatRect &world, std::size_t capacity)
+    : world(world), numProjectiles(0), numDropped(0), positionX(capacity), positionY(capacity), velocityX(capacity), velocityY(capacity),
+      previousX(capacity), previousY(capacity), width(capacity), height(capacity), lifetime(capacity), owner(capacity, OWNER_PLAYER)
+{
+}
+
+bool ProjectileStore::spawn(const sf::Vector2f &position, const sf::Vector2f &velocity, ProjectileOwner owner, float lifetime)
+{
+    if (numProjectiles == capacity())
+    {
+        numDropped++;
+        return false;
+    }
+    std::size_t i = numProjectiles++;
+    positionX[i] = previousX[i] = position.x;
+    positionY[i] = previousY[i] = position.y;
+    velocityX[i] = velocity.x;
+    velocityY[i] = velocity.y;
+    width[i] = sizeOf(owner).x;
+    height[i] = sizeOf(owner).y;
+    this->lifetime[i] = lifetime;
+    this->owner[i] = owner;
+    return true;
+}
+
+bool ProjectileStore::spawnLaser(const sf::Vector2f &position, bool movingRight)
+{
+    return spawn(position, sf::Vector2f(movingRight ? LASER_SPEED : -LASER_SPEED, 0.0f), OWNER_PLAYER, LASER_LIFETIME);
+}
+
+bool ProjectileStore::spawnMissile(const sf::Vector2f &position, const sf::Vector2f &targetPosition)
+{
+    sf::Vector2f direction = targetPosition - position;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length != 0)
+    {
+        direction /= length;
+    }
+    return spawn(position, direction * MISSILE_SPEED, OWNER_LANDER, MISSILE_LIFETIME);
+}
+
+void ProjectileStore::integrate(float deltaTime)
+{
+    // plain pointers and no branches, so this loop is vectorised
+    float *x = positionX.data();
+    float *y = positionY.data();
+    float *life = lifetime.data();
+    const float *vx = velocityX.data();
+    const float *vy = velocityY.data();
+    for (std::size_t i = 0; i < numProjectiles; i++)
+    {
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        life[i] -= deltaTime;
+    }
+}
+
+void ProjectileStore::cull()
+{
+    std::size_t i = 0;
+    while (i < numProjectiles)
+    {
+        if (!isAlive(i) || !getBounds(i).intersects(world))
+        {
+            removeAt(i); // the last projectile now sits at i, so check it next
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void ProjectileStore::kill(std::size_t index)
+{
+    lifetime[index] = 0.0f;
+}
+
+void ProjectileStore::clear()
+{
+    numProjectiles = 0;
+}
+
+void ProjectileStore::savePreviousPositions()
+{
+    for (std::size_t i = 0; i < numProjectiles; i++)
+    {
+        previousX[i] = positionX[i];
+        previousY[i] = positionY[i];
+    }
+}
+
+void ProjectileStore::draw(sf::RenderWindow &window, float alpha) const
+{
+    sf::RectangleShape laserShape(LASER_SIZE);
+    laserShape.setFillColor(sf::Color::Green);
+    sf::RectangleShape missileShape(MISSILE_SIZE);
+    missileShape.setFillColor(sf::Color::Red);
+
+    for (std::size_t i = 0; i < numProjectiles; i++)
+    {
+        if (!isAlive(i))
+        {
+            continue;
+        }
+        sf::RectangleShape &shape = owner[i] == OWNER_PLAYER ? laserShape : missileShape;
+        shape.setPosition(previousX[i] + (positionX[i] - previousX[i]) * alpha, previousY[i] + (positionY[i] - previousY[i]) * alpha);
+        window.draw(shape);
+    }
+}
+
+std::size_t ProjectileStore::size() const
+{
+    return numProjectiles;
+}
+
+std::size_t ProjectileStore::capacity() const
+{
+    return positionX.size();
+}
+
+std::size_t ProjectileStore::getNumDropped() const
+{
+    return numDropped;
+}
+
+std::size_t ProjectileStore::count(ProjectileOwner owner) const
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < numProjectiles; i++)
+    {
+        if (this->owner[i] == owner)
+        {
+            total++;
+        }
+    }
+    return total;
+}
+
+bool ProjectileStore::isAlive(std::size_t index) const
+{
+    return lifetime[index] > 0.0f;
+}
+
+ProjectileOwner ProjectileStore::getOwner(std::size_t index) const
+{
+    return owner[index];
+}
+
+sf::Vector2f ProjectileStore::getPosition(std::size_t index) const
+{
+    return sf::Vector2f(positionX[index], positionY[index]);
+}
+
+sf::Vector2f ProjectileStore::getVelocity(std::size_t index) const
+{
+    return sf::Vector2f(velocityX[index], velocityY[index]);
+}
+
+sf::FloatRect ProjectileStore::getBounds(std::size_t index) const
+{
+    return sf::FloatRect(positionX[index], positionY[index], width[index], height[index]);
+}
+
+void ProjectileStore::findOverlaps(const sf::FloatRect &box, std::vector<std::uint64_t> &hits) const
+{
+    hits.resize(getNumHitWords(numProjectiles));
+    intersectBoxes(box, positionX.data(), positionY.data(), width.data(), height.data(), numProjectiles, hits.data());
+}
+
+sf::FloatRect ProjectileStore::getPreviousBounds(std::size_t index) const
+{
+    return sf::FloatRect(previousX[index], previousY[index], width[index], height[index]);
+}
+
+sf::FloatRect ProjectileStore::getSweptBounds(std::size_t index) const
+{
+    float left = std::min(previousX[index], positionX[index]);
+    float top = std::min(previousY[index], positionY[index]);
+    return sf::FloatRect(left, top, std::abs(positionX[index] - previousX[index]) + width[index],
+                         std::abs(positionY[index] - previousY[index]) + height[index]);
+}
+
+bool ProjectileStore::sweep(std::size_t index, const sf::FloatRect &target, float &timeOfImpact) const
+{
+    sf::Vector2f displacement(positionX[index] - previousX[index], positionY[index] - previousY[index]);
+    return sweepBoxes(getPreviousBounds(index), displacement, target, timeOfImpact);
+}
+
+void ProjectileStore::removeAt(std::size_t index)
+{
+    std::size_t last = --numProjectiles;
+    positionX[index] = positionX[last];
+    positionY[index] = positionY[last];
+    velocityX[index] = velocityX[last];
+    velocityY[index] = velocityY[last];
+    previousX[index] = previousX[last];
+    previousY[index] = previousY[last];
+    width[index] = width[last];
+    height[index] = height[last];
+    lifetime[index] = lifetime[last];
+    owner[index] = owner[last];
+}
@@ -0,0 +1,235 @@
+#ifndef PROJECTILESTORE_H
+#define PROJECTILESTORE_H
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum ProjectileOwner
+ * @brief Who fired a projectile, which decides what it can hit and how it looks.
+ */
+enum ProjectileOwner : std::uint8_t
+{
+    OWNER_PLAYER, /**< A laser fired by the player's ship. */
+    OWNER_LANDER  /**< A missile fired by a lander at the player. */
+};
+
+const std::size_t PROJECTILE_CAPACITY = 512; // more than the lasers and missiles a game can have in flight
+const float LASER_SPEED = 900.0f;            // pixels per second
+const float MISSILE_SPEED = 200.0f;          // pixels per second
+
+/**
+ * @class ProjectileStore
+ * @brief Every laser and missile in flight, stored as parallel arrays with a fixed capacity.
+ *
+ * Each projectile is one index into the position, velocity, lifetime and owner arrays, so
+ * moving them all is a single loop over plain floats that the compiler can vectorise. Removing
+ * one moves the last projectile into its place, which means indices are only stable until the
+ * next cull(). The arrays never grow: once the capacity, PROJECTILE_CAPACITY unless given, is in
+ * flight, further spawns are dropped and counted by getNumDropped().
+ */
+class ProjectileStore
+{
+public:
+    /**
+     * @brief Construct a new, empty ProjectileStore object.
+     *
+     * @param world The area projectiles may fly in; any that leave it are culled.
+     * @param capacity The most projectiles that can be in flight at once.
+     */
+    explicit ProjectileStore(const sf::FloatRect &world, std::size_t capacity = PROJECTILE_CAPACITY);
+
+    /**
+     * @brief Add a projectile.
+     *
+     * @param position The top left corner of the projectile.
+     * @param velocity The projectile's velocity in pixels per second.
+     * @param owner Who fired it.
+     * @param lifetime How many seconds it flies before it is culled.
+     * @return True if it was added, false if the store is full.
+     */
+    bool spawn(const sf::Vector2f &position, const sf::Vector2f &velocity, ProjectileOwner owner, float lifetime);
+
+    /**
+     * @brief Add a laser fired by the player.
+     *
+     * @param position The top left corner of the laser.
+     * @param movingRight True if the laser flies to the right, false for the left.
+     * @return True if it was added, false if the store is full.
+     */
+    bool spawnLaser(const sf::Vector2f &position, bool movingRight);
+
+    /**
+     * @brief Add a missile fired by a lander.
+     *
+     * @param position The top left corner of the missile.
+     * @param targetPosition The position the missile flies towards, in a straight line.
+     * @return True if it was added, false if the store is full.
+     */
+    bool spawnMissile(const sf::Vector2f &position, const sf::Vector2f &targetPosition);
+
+    /**
+     * @brief Move every projectile along its velocity and shorten its lifetime.
+     *
+     * @param deltaTime The time passed since the last update, in seconds.
+     */
+    void integrate(float deltaTime);
+
+    /**
+     * @brief Remove the projectiles that were killed, ran out of lifetime or left the world.
+     */
+    void cull();
+
+    /**
+     * @brief Mark a projectile as spent; it is removed by the next cull().
+     *
+     * @param index The projectile's index.
+     */
+    void kill(std::size_t index);
+
+    /**
+     * @brief Remove every projectile.
+     */
+    void clear();
+
+    /**
+     * @brief Remember every current position so drawing can interpolate from it.
+     */
+    void savePreviousPositions();
+
+    /**
+     * @brief Draw every live projectile, lasers in green and missiles in red.
+     *
+     * @param window The SFML render window to draw on.
+     * @param alpha How far the frame is between the last two updates, from 0 to 1.
+     */
+    void draw(sf::RenderWindow &window, float alpha = 1.0f) const;
+
+    /**
+     * @brief Get the number of projectiles in the store, including killed ones not yet culled.
+     *
+     * @return The number of projectiles.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Get the most projectiles the store can hold.
+     *
+     * @return The capacity.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief Get the number of spawns dropped because the store was full, since it was made.
+     *
+     * @return The number of dropped spawns.
+     */
+    std::size_t getNumDropped() const;
+
+    /**
+     * @brief Count the projectiles fired by one owner.
+     *
+     * @param owner The owner to count.
+     * @return The number of that owner's projectiles.
+     */
+    std::size_t count(ProjectileOwner owner) const;
+
+    /**
+     * @brief Check if a projectile has not been killed or run out of lifetime.
+     *
+     * @param index The projectile's index.
+     * @return True if the projectile is still flying, false otherwise.
+     */
+    bool isAlive(std::size_t index) const;
+
+    /**
+     * @brief Get who fired a projectile.
+     *
+     * @param index The projectile's index.
+     * @return The projectile's owner.
+     */
+    ProjectileOwner getOwner(std::size_t index) const;
+
+    /**
+     * @brief Get the position of a projectile.
+     *
+     * @param index The projectile's index.
+     * @return The top left corner of the projectile.
+     */
+    sf::Vector2f getPosition(std::size_t index) const;
+
+    /**
+     * @brief Get the velocity of a projectile.
+     *
+     * @param index The projectile's index.
+     * @return The velocity in pixels per second.
+     */
+    sf::Vector2f getVelocity(std::size_t index) const;
+
+    /**
+     * @brief Get the bounding box of a projectile.
+     *
+     * @param index The projectile's index.
+     * @return The bounding box, sized by the projectile's owner.
+     */
+    sf::FloatRect getBounds(std::size_t index) const;
+
+    /**
+     * @brief Find every projectile whose bounding box overlaps a box, testing them several at a time.
+     *
+     * @param box The box to test.
+     * @param hits Filled with a hit mask: bit i of word i / 64 is set if projectile i overlaps the box.
+     */
+    void findOverlaps(const sf::FloatRect &box, std::vector<std::uint64_t> &hits) const;
+
+    /**
+     * @brief Get the bounding box of a projectile before the last update moved it.
+     *
+     * @param index The projectile's index.
+     * @return The bounding box at the projectile's previous position.
+     */
+    sf::FloatRect getPreviousBounds(std::size_t index) const;
+
+    /**
+     * @brief Get the box covering everywhere a projectile went during the last update.
+     *
+     * @param index The projectile's index.
+     * @return The smallest box holding both the previous and the current bounding box.
+     */
+    sf::FloatRect getSweptBounds(std::size_t index) const;
+
+    /**
+     * @brief Find when a projectile first overlapped a box while the last update moved it.
+     *
+     * @param index The projectile's index.
+     * @param target The box, which is taken to have stood still.
+     * @param timeOfImpact Set to how far through the update the projectile first overlapped it, from 0 to 1.
+     * @return True if the projectile overlapped the box at any point, false otherwise.
+     */
+    bool sweep(std::size_t index, const sf::FloatRect &target, float &timeOfImpact) const;
+
+private:
+    /**
+     * @brief Remove a projectile by moving the last one into its place.
+     *
+     * @param index The projectile's index.
+     */
+    void removeAt(std::size_t index);
+
+    sf::FloatRect world;                /**< Projectiles outside this area are culled. */
+    std::size_t numProjectiles;         /**< How many entries of the arrays are in use. */
+    std::size_t numDropped;             /**< Spawns turned away because the arrays were full. */
+    std::vector<float> positionX;       /**< Left edge of each projectile. */
+    std::vector<float> positionY;       /**< Top edge of each projectile. */
+    std::vector<float> velocityX;       /**< Horizontal velocity in pixels per second. */
+    std::vector<float> velocityY;       /**< Vertical velocity in pixels per second. */
+    std::vector<float> previousX;       /**< Left edge after the update before last. */
+    std::vector<float> previousY;       /**< Top edge after the update before last. */
+    std::vector<float> width;           /**< Width of each projectile, set by its owner. */
+    std::vector<float> height;          /**< Height of each projectile, set by its owner. */
+    std::vector<float> lifetime;        /**< Seconds left to fly; 0 or less once spent. */
+    std::vector<ProjectileOwner> owner; /**< Who fired each projectile. */
+};
+
+#endif
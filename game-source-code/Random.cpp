@@ -0,0 +1,48 @@
+#include "Random.h"
+
+const std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+// SplitMix64's finaliser, which turns consecutive inputs into well spread outputs
+static std::uint64_t mix(std::uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+Random::Random(std::uint64_t seed, std::uint64_t stream)
+    : key(mix(mix(seed + GOLDEN_GAMMA) + stream * GOLDEN_GAMMA)), counter(0)
+{
+}
+
+std::uint32_t Random::at(std::uint64_t key, std::uint64_t counter)
+{
+    return static_cast<std::uint32_t>(mix(key + (counter + 1) * GOLDEN_GAMMA) >> 32);
+}
+
+std::uint32_t Random::next()
+{
+    return at(key, counter++);
+}
+
+int Random::nextInt(int bound)
+{
+    // this scales the number into range with a multiply instead of %, which would favour small values
+    return static_cast<int>((static_cast<std::uint64_t>(next()) * static_cast<std::uint64_t>(bound)) >> 32);
+}
+
+float Random::nextFloat()
+{
+    // the top 24 bits fill a float's mantissa exactly
+    return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+}
+
+std::uint64_t Random::getKey() const
+{
+    return key;
+}
+
+std::uint64_t Random::getCounter() const
+{
+    return counter;
+}
@@ -0,0 +1,80 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+#include <cstdint>
+
+// stream numbers for the parts of the game that draw random numbers; every lander gets its own
+// stream, LANDER_STREAM_BASE plus the order it was spawned in
+const std::uint64_t FUEL_CAN_STREAM = 1;
+const std::uint64_t HUMANOID_SPAWN_STREAM = 2;
+const std::uint64_t LANDER_STREAM_BASE = 1000;
+
+/**
+ * @class Random
+ * @brief A seeded, counter-based random number generator.
+ *
+ * Each number is a hash of the stream's key and how many numbers came before it, so a stream
+ * is fully described by (seed, stream, counter). Streams never share state, which keeps runs
+ * reproducible from the seed no matter which entity, or which thread, asks for numbers first.
+ */
+class Random
+{
+public:
+    /**
+     * @brief Construct a new Random stream.
+     *
+     * @param seed The seed of the whole run.
+     * @param stream Which independent stream of that seed to draw from.
+     */
+    explicit Random(std::uint64_t seed = 1, std::uint64_t stream = 0);
+
+    /**
+     * @brief Get the number at a position in a stream without changing any state.
+     *
+     * @param key The stream's key.
+     * @param counter The position in the stream.
+     * @return A random 32-bit number.
+     */
+    static std::uint32_t at(std::uint64_t key, std::uint64_t counter);
+
+    /**
+     * @brief Get the next random 32-bit number.
+     *
+     * @return A random 32-bit number.
+     */
+    std::uint32_t next();
+
+    /**
+     * @brief Get the next random integer below a bound.
+     *
+     * @param bound The exclusive upper bound, which must be positive.
+     * @return A random integer from 0 to bound - 1.
+     */
+    int nextInt(int bound);
+
+    /**
+     * @brief Get the next random float between 0 and 1.
+     *
+     * @return A random float from 0 (inclusive) to 1 (exclusive).
+     */
+    float nextFloat();
+
+    /**
+     * @brief Get the key that identifies this stream.
+     *
+     * @return The stream's key.
+     */
+    std::uint64_t getKey() const;
+
+    /**
+     * @brief Get how many numbers have been drawn from this stream.
+     *
+     * @return The stream's counter.
+     */
+    std::uint64_t getCounter() const;
+
+private:
+    std::uint64_t key;     /**< Hash of the seed and stream number. */
+    std::uint64_t counter; /**< Position of the next number in the stream. */
+};
+
+#endif
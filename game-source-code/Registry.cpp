@@ -0,0 +1,102 @@
+#include "Registry.h"
+
+Registry::Registry()
+{
+}
+
+Entity Registry::create()
+{
+    std::uint32_t slot;
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(generations.size());
+        generations.push_back(0);
+    }
+    return makeEntity(slot, generations[slot]);
+}
+
+void Registry::destroy(Entity entity)
+{
+    if (!isAlive(entity))
+    {
+        return;
+    }
+    transforms.remove(entity);
+    velocities.remove(entity);
+    colliders.remove(entity);
+    bounds.remove(entity);
+    landers.remove(entity);
+    humanoids.remove(entity);
+    renderables.remove(entity);
+
+    // this makes every id of the entity stale before its slot is handed out again
+    std::uint32_t slot = getEntityIndex(entity);
+    generations[slot] = (generations[slot] + 1) & ENTITY_GENERATION_MASK;
+    freeSlots.push_back(slot);
+}
+
+void Registry::queueDestroy(Entity entity)
+{
+    destroyQueue.push_back(entity);
+}
+
+void Registry::flushDestroyed()
+{
+    for (Entity entity : destroyQueue)
+    {
+        destroy(entity); // an entity queued twice is only destroyed once
+    }
+    destroyQueue.clear();
+}
+
+bool Registry::isAlive(Entity entity) const
+{
+    // a free slot's generation was bumped when it was freed, so no id handed out matches it
+    std::uint32_t slot = getEntityIndex(entity);
+    return entity != NO_ENTITY && slot < generations.size() && generations[slot] == getEntityGeneration(entity);
+}
+
+void Registry::clear()
+{
+    transforms.clear();
+    velocities.clear();
+    colliders.clear();
+    bounds.clear();
+    landers.clear();
+    humanoids.clear();
+    renderables.clear();
+    destroyQueue.clear();
+
+    // this frees every slot, lowest first, without letting go of the memory
+    freeSlots.clear();
+    for (std::size_t slot = generations.size(); slot > 0; slot--)
+    {
+        std::uint32_t &generation = generations[slot - 1];
+        generation = (generation + 1) & ENTITY_GENERATION_MASK;
+        freeSlots.push_back(static_cast<std::uint32_t>(slot - 1));
+    }
+}
+
+void Registry::reserve(std::size_t numSlots)
+{
+    generations.reserve(numSlots);
+    freeSlots.reserve(numSlots);
+    destroyQueue.reserve(numSlots);
+    transforms.reserve(numSlots);
+    velocities.reserve(numSlots);
+    colliders.reserve(numSlots);
+    bounds.reserve(numSlots);
+    landers.reserve(numSlots);
+    humanoids.reserve(numSlots);
+    renderables.reserve(numSlots);
+}
+
+std::size_t Registry::getNumSlots() const
+{
+    return generations.size();
+}
@@ -0,0 +1,338 @@
+#ifndef REGISTRY_H
+#define REGISTRY_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Components.h"
+
+/**
+ * @brief An id that ties together the components of one game object.
+ *
+ * The low bits are the entity's slot and the high bits are the slot's generation, which goes up
+ * each time the slot is reused, so an id kept after its entity was destroyed never matches the
+ * entity that reuses the slot.
+ */
+typedef std::uint32_t Entity;
+
+const unsigned ENTITY_INDEX_BITS = 20;
+const std::uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+const std::uint32_t ENTITY_GENERATION_MASK = 0xFFFFFFFFu >> ENTITY_INDEX_BITS;
+const Entity NO_ENTITY = 0xFFFFFFFFu; // never handed out by a Registry
+
+/**
+ * @brief Get the slot of an entity.
+ *
+ * @param entity The entity.
+ * @return The slot, shared with every earlier entity that used it.
+ */
+inline std::uint32_t getEntityIndex(Entity entity)
+{
+    return entity & ENTITY_INDEX_MASK;
+}
+
+/**
+ * @brief Get how many times an entity's slot was reused before it.
+ *
+ * @param entity The entity.
+ * @return The generation, which wraps around.
+ */
+inline std::uint32_t getEntityGeneration(Entity entity)
+{
+    return entity >> ENTITY_INDEX_BITS;
+}
+
+/**
+ * @brief Make an entity from its slot and generation.
+ *
+ * @param index The slot.
+ * @param generation The generation of the slot.
+ * @return The entity.
+ */
+inline Entity makeEntity(std::uint32_t index, std::uint32_t generation)
+{
+    return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+}
+
+/**
+ * @class ComponentPool
+ * @brief Stores one kind of component densely, with constant time lookup by entity.
+ *
+ * The components sit next to each other in one array, in the same order as their entities in a
+ * second array, so systems walk them linearly. A sparse array maps an entity's slot to its place
+ * in the dense arrays. Removing a component moves the last one into its place.
+ *
+ * @tparam T The component type.
+ */
+template <typename T>
+class ComponentPool
+{
+public:
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    /**
+     * @brief Give an entity a component, replacing the one it had.
+     *
+     * @param entity The entity.
+     * @param component The component to store.
+     * @return The stored component.
+     */
+    T &add(Entity entity, const T &component)
+    {
+        std::uint32_t slot = getEntityIndex(entity);
+        if (slot >= sparse.size())
+        {
+            sparse.resize(slot + 1, NOT_STORED);
+        }
+        if (sparse[slot] != NOT_STORED)
+        {
+            entities[sparse[slot]] = entity;
+            return dense[sparse[slot]] = component;
+        }
+        sparse[slot] = static_cast<std::uint32_t>(dense.size());
+        dense.push_back(component);
+        entities.push_back(entity);
+        return dense.back();
+    }
+
+    /**
+     * @brief Take an entity's component away, if it has one.
+     *
+     * @param entity The entity.
+     */
+    void remove(Entity entity)
+    {
+        if (!has(entity))
+        {
+            return;
+        }
+        std::uint32_t slot = getEntityIndex(entity);
+        std::uint32_t index = sparse[slot];
+        std::uint32_t last = static_cast<std::uint32_t>(dense.size() - 1);
+        if (index != last)
+        {
+            dense[index] = dense[last];
+            entities[index] = entities[last];
+            sparse[getEntityIndex(entities[index])] = index;
+        }
+        dense.pop_back();
+        entities.pop_back();
+        sparse[slot] = NOT_STORED;
+    }
+
+    /**
+     * @brief Check if an entity has this component.
+     *
+     * @param entity The entity.
+     * @return True if the entity has the component, false otherwise, also when the entity was
+     * destroyed and its slot reused.
+     */
+    bool has(Entity entity) const
+    {
+        std::uint32_t slot = getEntityIndex(entity);
+        return slot < sparse.size() && sparse[slot] != NOT_STORED && entities[sparse[slot]] == entity;
+    }
+
+    /**
+     * @brief Get an entity's component, which it must have.
+     *
+     * @param entity The entity.
+     * @return The entity's component.
+     */
+    T &get(Entity entity)
+    {
+        return dense[sparse[getEntityIndex(entity)]];
+    }
+
+    /**
+     * @brief Get an entity's component, which it must have.
+     *
+     * @param entity The entity.
+     * @return The entity's component.
+     */
+    const T &get(Entity entity) const
+    {
+        return dense[sparse[getEntityIndex(entity)]];
+    }
+
+    /**
+     * @brief Get the place of an entity's component in the dense array, which it must have.
+     *
+     * @param entity The entity.
+     * @return The place, from 0 to size() - 1, until a component is removed.
+     */
+    std::size_t getIndex(Entity entity) const
+    {
+        return sparse[getEntityIndex(entity)];
+    }
+
+    /**
+     * @brief Get the entity that owns the component at a place in the dense array.
+     *
+     * @param index The place, from 0 to size() - 1.
+     * @return The owning entity.
+     */
+    Entity getEntity(std::size_t index) const
+    {
+        return entities[index];
+    }
+
+    /**
+     * @brief Get the component at a place in the dense array.
+     *
+     * @param index The place, from 0 to size() - 1.
+     * @return The component.
+     */
+    T &operator[](std::size_t index)
+    {
+        return dense[index];
+    }
+
+    /**
+     * @brief Get the component at a place in the dense array.
+     *
+     * @param index The place, from 0 to size() - 1.
+     * @return The component.
+     */
+    const T &operator[](std::size_t index) const
+    {
+        return dense[index];
+    }
+
+    /**
+     * @brief Get the number of components stored.
+     *
+     * @return The number of components.
+     */
+    std::size_t size() const
+    {
+        return dense.size();
+    }
+
+    /**
+     * @brief Make room for components of the first few slots, so adding them allocates nothing.
+     *
+     * @param numSlots The number of slots.
+     */
+    void reserve(std::size_t numSlots)
+    {
+        dense.reserve(numSlots);
+        entities.reserve(numSlots);
+        if (sparse.size() < numSlots)
+        {
+            sparse.resize(numSlots, NOT_STORED);
+        }
+    }
+
+    /**
+     * @brief Remove every component.
+     */
+    void clear()
+    {
+        dense.clear();
+        entities.clear();
+        sparse.clear();
+    }
+
+    iterator begin() { return dense.begin(); }
+    iterator end() { return dense.end(); }
+    const_iterator begin() const { return dense.begin(); }
+    const_iterator end() const { return dense.end(); }
+
+private:
+    static constexpr std::uint32_t NOT_STORED = 0xFFFFFFFFu;
+
+    std::vector<T> dense;              /**< The components, packed. */
+    std::vector<Entity> entities;      /**< The owner of each packed component. */
+    std::vector<std::uint32_t> sparse; /**< Place of each slot's component, or NOT_STORED. */
+};
+
+/**
+ * @class Registry
+ * @brief Hands out entities and keeps one ComponentPool for each kind of component.
+ *
+ * Game objects are entities with a set of components rather than classes of their own: a lander
+ * is a Transform, a Collider, a LanderAI and a Renderable. Systems, such as updateLanders() and
+ * drawSprites(), each loop over the pools they need.
+ *
+ * The slots of destroyed entities are reused by the next ones created, with a new generation, so
+ * the pools stop growing once the number of entities alive at once stops growing. Entities that die
+ * during an update are queued and removed together at its end, so the pools only ever hold the
+ * living and systems never visit the dead for more than one update.
+ */
+class Registry
+{
+public:
+    /**
+     * @brief Construct a new Registry object with no entities.
+     */
+    Registry();
+
+    /**
+     * @brief Make a new entity with no components, in the slot of a destroyed one if there is one.
+     *
+     * @return The new entity.
+     */
+    Entity create();
+
+    /**
+     * @brief Remove every component of an entity and free its slot. Does nothing if it was already destroyed.
+     *
+     * @param entity The entity.
+     */
+    void destroy(Entity entity);
+
+    /**
+     * @brief Destroy an entity at the next flushDestroyed(), so loops that are visiting it can finish first.
+     *
+     * @param entity The entity.
+     */
+    void queueDestroy(Entity entity);
+
+    /**
+     * @brief Destroy every entity queued since the last flush, compacting the pools.
+     */
+    void flushDestroyed();
+
+    /**
+     * @brief Check if an entity was created and not destroyed since.
+     *
+     * @param entity The entity.
+     * @return True if the entity is alive, false otherwise.
+     */
+    bool isAlive(Entity entity) const;
+
+    /**
+     * @brief Remove every entity and component, keeping the slots for the next entities.
+     */
+    void clear();
+
+    /**
+     * @brief Make room for a number of entities alive at once, so creating them allocates nothing.
+     *
+     * @param numSlots The number of entities.
+     */
+    void reserve(std::size_t numSlots);
+
+    /**
+     * @brief Get the number of slots ever used, alive or free.
+     *
+     * @return The number of slots.
+     */
+    std::size_t getNumSlots() const;
+
+    ComponentPool<Transform> transforms;   /**< Where every entity is. */
+    ComponentPool<Velocity> velocities;    /**< How fast the entities that move on their own travel. */
+    ComponentPool<Collider> colliders;     /**< The bounding boxes of the entities that collide. */
+    ComponentPool<Bounds> bounds;          /**< Where those bounding boxes are in the world. */
+    ComponentPool<LanderAI> landers;       /**< The state of every lander. */
+    ComponentPool<HumanoidAI> humanoids;   /**< The state of every humanoid. */
+    ComponentPool<Renderable> renderables; /**< How to draw the entities that are visible. */
+
+private:
+    std::vector<std::uint32_t> generations; /**< The current generation of each slot. */
+    std::vector<std::uint32_t> freeSlots;   /**< The slots of destroyed entities, reused last in first out. */
+    std::vector<Entity> destroyQueue;       /**< The entities to destroy at the next flushDestroyed(). */
+};
+
+#endif
@@ -0,0 +1,21 @@
+#include "RenderSystem.h"
+#include "Interpolation.h"
+
+void savePreviousPositions(Registry &registry)
+{
+    for (Transform &transform : registry.transforms)
+    {
+        transform.previousPosition = transform.position;
+    }
+}
+
+void drawSprites(const Registry &registry, sf::RenderWindow &window, float alpha)
+{
+    for (std::size_t i = 0; i < registry.renderables.size(); i++)
+    {
+        const Transform &transform = registry.transforms.get(registry.renderables.getEntity(i));
+        sf::Sprite sprite = *registry.renderables[i].sprite;
+        sprite.setPosition(interpolate(transform.previousPosition, transform.position, alpha));
+        window.draw(sprite);
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef RENDERSYSTEM_H
+#define RENDERSYSTEM_H
+#include <SFML/Graphics.hpp>
+#include "Registry.h"
+
+/**
+ * @brief Remember every entity's position so drawing can interpolate from it.
+ *
+ * @param registry The registry that holds the entities.
+ */
+void savePreviousPositions(Registry &registry);
+
+/**
+ * @brief Draw every entity that has a Renderable, between its last two positions.
+ *
+ * @param registry The registry that holds the entities.
+ * @param window The SFML render window to draw on.
+ * @param alpha How far the frame is between the last two updates, from 0 to 1.
+ */
+void drawSprites(const Registry &registry, sf::RenderWindow &window, float alpha = 1.0f);
+
+#endif
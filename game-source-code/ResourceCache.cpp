@@ -0,0 +1,101 @@
+#include "ResourceCache.h"
+#include <iostream>
+
+// this loads a file into the cache the first time it is asked for, and finds it every time after
+template <typename T>
+static T &loadOnce(std::map<std::string, std::unique_ptr<T>> &cache, const std::string &filename, std::size_t &numFilesRead)
+{
+    auto found = cache.find(filename);
+    if (found == cache.end())
+    {
+        std::unique_ptr<T> resource(new T());
+        numFilesRead++;
+        if (!resource->loadFromFile(filename))
+        {
+            std::cerr << "Failed to load " << filename << std::endl;
+        }
+        found = cache.emplace(filename, std::move(resource)).first;
+    }
+    return *found->second;
+}
+
+sf::Texture &ResourceCache::getTexture(const std::string &filename)
+{
+    // this builds the texture from the cached image, so a file used for a sprite and a pixel mask is decoded once
+    std::unique_ptr<sf::Texture> &texture = textures[filename];
+    if (!texture)
+    {
+        texture.reset(new sf::Texture());
+        const sf::Image &image = getImage(filename);
+        if (image.getSize().x > 0 && image.getSize().y > 0)
+        {
+            texture->loadFromImage(image);
+        }
+    }
+    return *texture;
+}
+
+const sf::Image &ResourceCache::getImage(const std::string &filename)
+{
+    return loadOnce(images, filename, numFilesRead);
+}
+
+const PixelMask &ResourceCache::getPixelMask(const std::string &filename, const sf::Vector2u &size, bool mirrored)
+{
+    std::string key = filename + "@" + std::to_string(size.x) + "x" + std::to_string(size.y) + (mirrored ? "m" : "");
+    std::unique_ptr<PixelMask> &mask = pixelMasks[key];
+    if (!mask)
+    {
+        mask.reset(new PixelMask(getImage(filename), size, mirrored));
+    }
+    return *mask;
+}
+
+const sf::Font &ResourceCache::getFont(const std::string &filename)
+{
+    return loadOnce(fonts, filename, numFilesRead);
+}
+
+#ifndef SIM_HEADLESS
+const sf::SoundBuffer &ResourceCache::getSoundBuffer(const std::string &filename)
+{
+    return loadOnce(soundBuffers, filename, numFilesRead);
+}
+#endif
+
+bool ResourceCache::loadSprite(sf::Sprite &sprite, const std::string &filename, bool smooth)
+{
+#ifdef SIM_HEADLESS
+    (void)smooth; // there are no textures to smooth without a window
+    sf::Vector2u size = getImage(filename).getSize();
+    if (size.x == 0 || size.y == 0)
+    {
+        return false;
+    }
+    sprite.setTextureRect(sf::IntRect(0, 0, size.x, size.y));
+    return true;
+#else
+    sf::Texture &texture = getTexture(filename);
+    if (texture.getSize().x == 0 || texture.getSize().y == 0)
+    {
+        return false;
+    }
+    if (smooth)
+    {
+        texture.setSmooth(true);
+    }
+    sprite.setTexture(texture, true);
+    return true;
+#endif
+}
+
+std::size_t ResourceCache::getNumFilesRead() const
+{
+    return numFilesRead;
+}
+
+ResourceCache &getResourceCache()
+{
+    static ResourceCache cache;
+    return cache;
+}
@@ -0,0 +1,107 @@
+#ifndef RESOURCECACHE_H
+#define RESOURCECACHE_H
+#include <SFML/Graphics.hpp>
+#include "PixelMask.h"
+#ifndef SIM_HEADLESS
+#include <SFML/Audio.hpp>
+#endif
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+/**
+ * @class ResourceCache
+ * @brief Loads each texture, font and sound buffer once and shares it with everything that uses it.
+ *
+ * Resources are kept by filename for the life of the program, so the references handed out never
+ * dangle and sprites, texts and sounds can hold on to them instead of keeping their own copies.
+ * A file that fails to load is reported once and cached empty, so it is not retried every frame.
+ *
+ * In headless builds (SIM_HEADLESS defined) no texture is uploaded and no audio is used, because
+ * those need a display and a sound device. Sprites only get the image size as their texture
+ * rectangle, so they still have the right bounds for collisions.
+ */
+class ResourceCache
+{
+public:
+    /**
+     * @brief Get the texture made from a file's cached image, making it the first time it is asked for.
+     *
+     * @param filename The image file.
+     * @return The shared texture, which is empty if the file could not be loaded.
+     */
+    sf::Texture &getTexture(const std::string &filename);
+
+    /**
+     * @brief Get the image loaded from a file, loading it the first time it is asked for.
+     *
+     * @param filename The image file.
+     * @return The shared image, which is empty if the file could not be loaded.
+     */
+    const sf::Image &getImage(const std::string &filename);
+
+    /**
+     * @brief Get the pixel mask of an image at a size, building it the first time it is asked for.
+     *
+     * @param filename The image file.
+     * @param size The width and height of the mask in pixels.
+     * @param mirrored Whether the image is flipped left to right.
+     * @return The shared mask, which has no solid pixels if the file could not be loaded.
+     */
+    const PixelMask &getPixelMask(const std::string &filename, const sf::Vector2u &size, bool mirrored = false);
+
+    /**
+     * @brief Get the font loaded from a file, loading it the first time it is asked for.
+     *
+     * @param filename The font file.
+     * @return The shared font.
+     */
+    const sf::Font &getFont(const std::string &filename);
+
+#ifndef SIM_HEADLESS
+    /**
+     * @brief Get the sound buffer loaded from a file, loading it the first time it is asked for.
+     *
+     * @param filename The sound file.
+     * @return The shared sound buffer.
+     */
+    const sf::SoundBuffer &getSoundBuffer(const std::string &filename);
+#endif
+
+    /**
+     * @brief Attach the texture loaded from a file to a sprite, resizing the sprite to fit it.
+     *
+     * @param sprite The sprite.
+     * @param filename The image file.
+     * @param smooth Whether the shared texture is smoothed when it is scaled.
+     * @return True if the image was loaded, false otherwise.
+     */
+    bool loadSprite(sf::Sprite &sprite, const std::string &filename, bool smooth = false);
+
+    /**
+     * @brief Get the number of files read from disk so far, whether they loaded or not.
+     *
+     * @return The number of files read.
+     */
+    std::size_t getNumFilesRead() const;
+
+private:
+    std::map<std::string, std::unique_ptr<sf::Texture>> textures;
+    std::map<std::string, std::unique_ptr<sf::Image>> images; /**< For textures and pixel masks, and for the sizes in headless builds. */
+    std::map<std::string, std::unique_ptr<PixelMask>> pixelMasks; /**< Keyed by filename, size and mirroring. */
+    std::map<std::string, std::unique_ptr<sf::Font>> fonts;
+#ifndef SIM_HEADLESS
+    std::map<std::string, std::unique_ptr<sf::SoundBuffer>> soundBuffers;
+#endif
+    std::size_t numFilesRead = 0;
+};
+
+/**
+ * @brief Get the resource cache shared by the whole program.
+ *
+ * @return The resource cache.
+ */
+ResourceCache &getResourceCache();
+
+#endif
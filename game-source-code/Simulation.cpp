@@ -0,0 +1,636 @@
+#include "Simulation.h"
+#include "ResourceCache.h"
+#include "FrameProfiler.h"
+#include "LanderSystem.h"
+#include "HumanoidSystem.h"
+#include "RenderSystem.h"
+#include "CollisionSystem.h"
+#include "BatchIntersect.h"
+#include <iostream>
+
+const float LANDER_SPAWN_COOLDOWN = 1.5f;
+const int INITIAL_NUM_LIVES = 3;
+const int INITIAL_NUM_SHIELDS = 3;
+const int SHIELD_EFFECT_LENGTH = 5.0f;
+const float MISSILE_SPAWN_INTERVAL = 5.0f;
+const float MISSILE_HIT_COOLDOWN = 1.5f; // seconds after a missile hit before another one counts
+const float LANDER_HIT_COOLDOWN = 2.0f;  // seconds after a lander crash before another one counts
+
+// the three screen wide world the background scrolls over, with room for projectiles past its edges
+const sf::FloatRect COLLISION_WORLD(-WINDOW_WIDTH, -PROJECTILE_CULL_MARGIN, 3 * WINDOW_WIDTH, WINDOW_HEIGHT + 2 * PROJECTILE_CULL_MARGIN);
+
+Simulation::Simulation(const SimConfig &config)
+    : player(Random(config.seed, FUEL_CAN_STREAM)),
+      projectiles(sf::FloatRect(-PROJECTILE_CULL_MARGIN, -PROJECTILE_CULL_MARGIN, WINDOW_WIDTH + 2 * PROJECTILE_CULL_MARGIN, WINDOW_HEIGHT + 2 * PROJECTILE_CULL_MARGIN)),
+      config(config), score(0), numLives(INITIAL_NUM_LIVES), numShields(INITIAL_NUM_SHIELDS), numHumanoids(config.maxHumanoids),
+      totalLandersSpawned(0), numLandersDestroyed(0), numHumanoidsInTotal(0), numUpdates(0), shieldOn(false), gameOver(false), gameWon(false),
+      allHumanoidsDead(false), outOfFuel(false), humanoidRandom(config.seed, HUMANOID_SPAWN_STREAM),
+      landerGrid(COLLISION_WORLD, COLLISION_CELL_SIZE), humanoidGrid(COLLISION_WORLD, COLLISION_CELL_SIZE),
+      flockGrid(COLLISION_WORLD, FLOCK_RADIUS), workers(config.numThreads)
+{
+    // this shares one texture between every lander and humanoid, so spawning never loads a file
+    ResourceCache &resources = getResourceCache();
+    if (!resources.loadSprite(landerSprite, "resources/landership.png", true))
+    {
+        std::cerr << "Failed to load lander texture" << std::endl;
+    }
+    landerSprite.setScale(0.2f, 0.2f);
+    landerSprite.setOrigin(landerSprite.getLocalBounds().width / 2, landerSprite.getLocalBounds().height / 2);
+
+    if (!resources.loadSprite(humanoidSprite, "resources/humanoid.png"))
+    {
+        std::cerr << "Failed to load humanoid texture!" << std::endl;
+    }
+    humanoidSprite.setScale(0.125f, 0.125f);
+    landerMask = &resources.getPixelMask("resources/landership.png", getMaskSize(landerSprite.getGlobalBounds()));
+    humanoidMask = &resources.getPixelMask("resources/humanoid.png", getMaskSize(humanoidSprite.getGlobalBounds()));
+
+    // every lander and humanoid of a game fits without the registry growing mid-game
+    registry.reserve(config.maxLanders + config.maxHumanoids);
+    collisions.reserve(PROJECTILE_CAPACITY + config.maxLanders);
+
+    startTimers();
+}
+
+void Simulation::update(float deltaTime, const InputState &input)
+{
+    events = SimEvents();
+    savePreviousPositions();
+    events.laserFired = player.applyInput(input, projectiles, timers, deltaTime);
+
+    // this moves the landers once per update, even before the game starts
+    {
+        PROFILE_PHASE(profiler, PHASE_LANDERS);
+        sliceLanderAI(registry, player.getPlayerPosition().x, numUpdates++);
+        assignLanderTargets(registry, humanoidTargets, workers);
+        ::updateLanders(registry, deltaTime, workers);
+        flockLanders(registry, flockGrid, deltaTime, workers);
+    }
+
+    if (numLandersDestroyed >= config.maxLanders && numLives != 0)
+    {
+        gameWon = true;
+        gameOver = true;
+    }
+
+    if (!player.isGamePlaying())
+    {
+        return;
+    }
+
+    // the timers only run while the game is played, so nothing spawns behind the splash screen
+    timers.advance(deltaTime);
+
+    player.update();
+
+    updateProjectiles(deltaTime);
+
+    spawnHumanoids();
+
+    updateHumanoids(deltaTime);
+
+    // everything that moves on its own has moved, so the collision checks below all read the same boxes
+    updateBounds(registry);
+
+    detectProjectileCollisions(deltaTime);
+
+    if (input.shield && !timers.isPending(shieldTimer))
+    {
+        if (numShields > 0)
+        {
+            // this raises the shield until its timer lowers it again
+            shieldTimer = timers.schedule(SHIELD_EFFECT_LENGTH, [this]()
+                                          { shieldOn = false; });
+            shieldOn = true;
+            events.shieldRaised = true;
+            numShields--;
+        }
+    }
+
+    events.fuelCollected = player.fuelCanCollision(timers);
+
+    checkPlayerHumanoidCollision(deltaTime);
+
+    if (player.getFuel() <= 0)
+    {
+        // Player has run out of fuel, trigger game over
+        outOfFuel = true;
+        gameOver = true;
+    }
+
+    checkLanderCollisions();
+
+    resolveCollisions();
+
+    // hits only kill projectiles, so they are all removed together once nothing else will look at them
+    projectiles.cull();
+    removeDestroyedEntities();
+}
+
+void Simulation::removeDestroyedEntities()
+{
+    // this lets each lander destroyed this update drop the humanoid it carries before it is removed
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        if (registry.landers[i].destroyed)
+        {
+            checkLanderHumanoidCollisions(registry.landers.getEntity(i));
+        }
+    }
+    registry.flushDestroyed();
+}
+
+// the candidates come in pool order and only an earlier impact replaces a hit, so ties go to the first found
+template <>
+bool Simulation::sweepLayer<LAYER_HUMANOID>(std::size_t index, const sf::FloatRect &sweptBounds, float &firstImpact, Entity &hit)
+{
+    bool found = false;
+    humanoidGrid.queryOverlaps(sweptBounds, collisionCandidates);
+    for (std::uint32_t h : collisionCandidates)
+    {
+        Entity humanoid = registry.humanoids.getEntity(h);
+        const HumanoidAI &ai = registry.humanoids[h];
+        const Transform &transform = registry.transforms.get(humanoid);
+        float timeOfImpact;
+        const sf::FloatRect &humanoidBounds = registry.bounds.get(humanoid).world;
+        if (!ai.captured && !ai.destroyed && (ai.falling || transform.position.y == WINDOW_HEIGHT - 100) &&
+            projectiles.sweep(index, humanoidBounds, timeOfImpact) && timeOfImpact < firstImpact &&
+            masksOverlap(sweptBounds, nullptr, humanoidBounds, registry.colliders.get(humanoid).mask))
+        {
+            firstImpact = timeOfImpact;
+            hit = humanoid;
+            found = true;
+        }
+    }
+    return found;
+}
+
+template <>
+bool Simulation::sweepLayer<LAYER_LANDER>(std::size_t index, const sf::FloatRect &sweptBounds, float &firstImpact, Entity &hit)
+{
+    bool found = false;
+    landerGrid.queryOverlaps(sweptBounds, collisionCandidates);
+    for (std::uint32_t l : collisionCandidates)
+    {
+        Entity lander = registry.landers.getEntity(l);
+        float timeOfImpact;
+        const sf::FloatRect &landerBounds = registry.bounds.get(lander).world;
+        if (!registry.landers[l].destroyed && projectiles.sweep(index, landerBounds, timeOfImpact) && timeOfImpact < firstImpact &&
+            masksOverlap(sweptBounds, nullptr, landerBounds, registry.colliders.get(lander).mask))
+        {
+            firstImpact = timeOfImpact;
+            hit = lander;
+            found = true;
+        }
+    }
+    return found;
+}
+
+template <>
+bool Simulation::sweepLayer<LAYER_PLAYER>(std::size_t index, const sf::FloatRect &sweptBounds, float &firstImpact, Entity &hit)
+{
+    float timeOfImpact;
+    bool nearPlayer = (projectileHits[index / 64] >> (index % 64)) & 1;
+    if (nearPlayer && projectiles.sweep(index, player.getPlayerBounds(), timeOfImpact) && timeOfImpact < firstImpact &&
+        masksOverlap(sweptBounds, nullptr, player.getPlayerBounds(), &player.getPlayerMask()))
+    {
+        firstImpact = timeOfImpact;
+        hit = NO_ENTITY;
+        return true;
+    }
+    return false;
+}
+
+template <>
+void Simulation::overlapLayer<LAYER_LANDER>(std::uint8_t layers, const sf::FloatRect &bounds, const PixelMask *mask)
+{
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        Entity lander = registry.landers.getEntity(i);
+        if (!registry.landers[i].destroyed && masksOverlap(bounds, mask, registry.bounds.get(lander).world, registry.colliders.get(lander).mask))
+        {
+            collisions.push_back({layers, 0, lander});
+        }
+    }
+}
+
+template <std::uint8_t Layer>
+void Simulation::detectProjectileCollision(std::size_t index)
+{
+    // the projectile is swept along its whole path this update, so it cannot jump over anything
+    sf::FloatRect sweptBounds = projectiles.getSweptBounds(index);
+    float firstImpact = 2.0f;
+    CollisionEvent hit = {0, static_cast<std::uint32_t>(index), NO_ENTITY};
+    GameCollisions::forEachPairFrom<Layer>([&](auto pair)
+                                           {
+                                               if (sweepLayer<decltype(pair)::second>(index, sweptBounds, firstImpact, hit.entity))
+                                               {
+                                                   hit.layers = decltype(pair)::layers;
+                                               } });
+
+    // each projectile reports only the first thing it hit
+    if (hit.layers != 0)
+    {
+        collisions.push_back(hit);
+    }
+}
+
+void Simulation::detectProjectileCollisions(float deltaTime)
+{
+    PROFILE_PHASE(profiler, PHASE_COLLISIONS);
+    buildHumanoidGrid();
+    buildLanderGrid();
+
+    // a missile that crossed the player this update ends it no further away than a missile flies in one
+    sf::FloatRect playerBounds = player.getPlayerBounds();
+    float reach = MISSILE_SPEED * deltaTime;
+    sf::FloatRect reachBounds(playerBounds.left - reach, playerBounds.top - reach, playerBounds.width + 2 * reach, playerBounds.height + 2 * reach);
+    projectiles.findOverlaps(reachBounds, projectileHits);
+
+    for (std::size_t i = 0; i < projectiles.size(); i++)
+    {
+        if (!projectiles.isAlive(i))
+        {
+            continue;
+        }
+        if (projectiles.getOwner(i) == OWNER_PLAYER)
+        {
+            detectProjectileCollision<LAYER_LASER>(i);
+        }
+        else
+        {
+            detectProjectileCollision<LAYER_MISSILE>(i);
+        }
+    }
+}
+
+// an earlier response may already have used up either side, so each one checks before it acts
+template <>
+void Simulation::respond<LAYER_LASER, LAYER_HUMANOID>(const CollisionEvent &collision)
+{
+    const HumanoidAI &ai = registry.humanoids.get(collision.entity);
+    if (projectiles.isAlive(collision.index) && !ai.captured && !ai.destroyed)
+    {
+        score -= 50;
+        destroyHumanoid(registry, collision.entity);
+        events.humanoidKilled = true;
+        numHumanoids--;
+        projectiles.kill(collision.index);
+    }
+}
+
+template <>
+void Simulation::respond<LAYER_LASER, LAYER_LANDER>(const CollisionEvent &collision)
+{
+    if (projectiles.isAlive(collision.index) && !registry.landers.get(collision.entity).destroyed)
+    {
+        destroyLander(registry, collision.entity);
+        events.landerDestroyed = true;
+        score += 50;
+        numLandersDestroyed++;
+        projectiles.kill(collision.index);
+    }
+}
+
+template <>
+void Simulation::respond<LAYER_MISSILE, LAYER_PLAYER>(const CollisionEvent &collision)
+{
+    if (projectiles.isAlive(collision.index) && !shieldOn && !timers.isPending(missileHitTimer))
+    {
+        events.playerHit = true;
+        missileHitTimer = timers.schedule(MISSILE_HIT_COOLDOWN, nullptr);
+        numLives--;
+        if (numLives <= 0)
+        {
+            gameOver = true;
+        }
+        projectiles.kill(collision.index);
+    }
+}
+
+template <>
+void Simulation::respond<LAYER_PLAYER, LAYER_LANDER>(const CollisionEvent &collision)
+{
+    if (!registry.landers.get(collision.entity).destroyed && !shieldOn && !timers.isPending(landerHitTimer))
+    {
+        events.playerHit = true;
+        landerHitTimer = timers.schedule(LANDER_HIT_COOLDOWN, nullptr);
+
+        numLives--;
+        numLandersDestroyed++;
+        if (numLives <= 0)
+        {
+            gameOver = true;
+            gameWon = false;
+        }
+        destroyLander(registry, collision.entity);
+    }
+}
+
+void Simulation::resolveCollisions()
+{
+    PROFILE_PHASE(profiler, PHASE_COLLISIONS);
+    for (const CollisionEvent &collision : collisions)
+    {
+        GameCollisions::dispatch(collision.layers, [&](auto pair)
+                                 { respond<decltype(pair)::first, decltype(pair)::second>(collision); });
+    }
+    collisions.clear();
+}
+
+void Simulation::buildLanderGrid()
+{
+    landerGrid.clear();
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        Entity lander = registry.landers.getEntity(i);
+        landerGrid.insert(static_cast<std::uint32_t>(i), registry.bounds.get(lander).world);
+    }
+    landerGrid.build();
+}
+
+void Simulation::buildHumanoidGrid()
+{
+    humanoidGrid.clear();
+    for (std::size_t i = 0; i < registry.humanoids.size(); i++)
+    {
+        Entity humanoid = registry.humanoids.getEntity(i);
+        humanoidGrid.insert(static_cast<std::uint32_t>(i), registry.bounds.get(humanoid).world);
+    }
+    humanoidGrid.build();
+}
+
+void Simulation::checkLanderCollisions()
+{
+    PROFILE_PHASE(profiler, PHASE_LANDERS);
+    checkLanderHumanoidCollisions();
+
+    // this checks for collision between player and everything the player runs into
+    GameCollisions::forEachPairFrom<LAYER_PLAYER>([&](auto pair)
+                                                  { overlapLayer<decltype(pair)::second>(decltype(pair)::layers, player.getPlayerBounds(), &player.getPlayerMask()); });
+}
+
+void Simulation::updateProjectiles(float deltaTime)
+{
+    PROFILE_PHASE(profiler, PHASE_MISSILES);
+    projectiles.integrate(deltaTime);
+}
+
+void Simulation::reset()
+{
+    // this resets game-related variables to their initial values
+    score = 0;
+    numLives = INITIAL_NUM_LIVES;
+    numShields = INITIAL_NUM_SHIELDS;
+    numHumanoids = config.maxHumanoids;
+    allHumanoidsDead = false;
+    outOfFuel = false;
+
+    numHumanoidsInTotal = 0;
+    humanoidRandom = Random(config.seed, HUMANOID_SPAWN_STREAM);
+    totalLandersSpawned = 0;
+    numLandersDestroyed = 0;
+    player.setFuel(100);
+
+    projectiles.clear();
+    gameOver = false;
+    gameWon = false;
+    // this removes the landers and humanoids
+    registry.clear();
+    shieldOn = false;
+    // this drops the last game's spawns and cooldowns, so only the new game's are left to fire
+    timers.clear();
+    startTimers();
+    player.PlayerSprite.setPosition(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2);
+    player.updateBounds();
+}
+
+void Simulation::spawnLander()
+{
+    if (totalLandersSpawned < config.maxLanders)
+    {
+        // each lander draws from its own stream, so where it spawns depends only on the seed and its spawn order
+        Random random(config.seed, LANDER_STREAM_BASE + totalLandersSpawned);
+        createLander(registry, random, landerSprite, landerMask);
+
+        // Increment the total number of landers spawned
+        totalLandersSpawned++;
+    }
+}
+
+void Simulation::spawnMissilesFromLanders()
+{
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        if (!registry.landers[i].destroyed)
+        {
+            sf::Vector2f landerPosition = registry.transforms.get(registry.landers.getEntity(i)).position;
+            sf::Vector2f playerPosition = player.getPlayerPosition();
+            // this creates a new missile with the player's position as the target
+            projectiles.spawnMissile(landerPosition, playerPosition);
+        }
+    }
+}
+
+void Simulation::spawnHumanoids()
+{
+    if (numHumanoidsInTotal < config.maxHumanoids) // Limit the total number of humanoids
+    {
+        // Generate a random position at the bottom of the screen
+        float x = static_cast<float>(humanoidRandom.nextInt(WINDOW_WIDTH));
+        float y = static_cast<float>(WINDOW_HEIGHT - 100);
+
+        createHumanoid(registry, sf::Vector2f(x, y), humanoidSprite, humanoidMask);
+        numHumanoidsInTotal++;
+    }
+}
+
+void Simulation::scheduleLanderSpawn()
+{
+    timers.schedule(LANDER_SPAWN_COOLDOWN, [this]()
+                    {
+                        spawnLander();
+                        scheduleLanderSpawn(); });
+}
+
+void Simulation::scheduleMissileSpawn()
+{
+    timers.schedule(MISSILE_SPAWN_INTERVAL, [this]()
+                    {
+                        spawnMissilesFromLanders();
+                        scheduleMissileSpawn(); });
+}
+
+void Simulation::startTimers()
+{
+    // the shield and the hit cooldowns start out pending, as they always have
+    scheduleLanderSpawn();
+    scheduleMissileSpawn();
+    shieldTimer = timers.schedule(SHIELD_EFFECT_LENGTH, nullptr);
+    missileHitTimer = timers.schedule(MISSILE_HIT_COOLDOWN, nullptr);
+    landerHitTimer = timers.schedule(LANDER_HIT_COOLDOWN, nullptr);
+    player.startTimers(timers);
+}
+
+void Simulation::savePreviousPositions()
+{
+    player.savePreviousPosition();
+    projectiles.savePreviousPositions();
+    ::savePreviousPositions(registry);
+}
+
+void Simulation::updateHumanoids(float deltaTime)
+{
+    ::updateHumanoids(registry, numHumanoids, deltaTime);
+    // dead humanoids have already left the registry, so this counts the ones spawned rather than the ones in it
+    if (numHumanoidsInTotal > 0 && numHumanoids <= 0)
+    {
+        allHumanoidsDead = true;
+        gameOver = true;
+        gameWon = false;
+    }
+}
+
+void Simulation::checkLanderHumanoidCollisions(Entity lander)
+{
+    LanderAI &landerAI = registry.landers.get(lander);
+    const Transform &landerTransform = registry.transforms.get(lander);
+    const sf::FloatRect &landerBounds = registry.bounds.get(lander).world;
+
+    for (std::size_t i = 0; i < registry.humanoids.size(); i++)
+    {
+        Entity humanoid = registry.humanoids.getEntity(i);
+        const HumanoidAI &ai = registry.humanoids[i];
+        if (registry.bounds.get(humanoid).world.intersects(landerBounds))
+        {
+            captureHumanoid(registry, humanoid, landerTransform.position);
+            landerAI.captured = true;
+        }
+        else if (landerAI.captured && ai.captured && !landerAI.destroyed)
+        {
+            captureHumanoid(registry, humanoid, landerTransform.position);
+        }
+        else if (landerAI.destroyed && ai.captured)
+        {
+            releaseHumanoid(registry, humanoid);
+        }
+    }
+}
+
+void Simulation::checkLanderHumanoidCollisions()
+{
+    // this marks the landers that touch a humanoid; there are far fewer humanoids than landers
+    buildLanderGrid();
+    landerNearHumanoid.assign(registry.landers.size(), 0);
+    for (std::size_t h = 0; h < registry.humanoids.size(); h++)
+    {
+        Entity humanoid = registry.humanoids.getEntity(h);
+        landerGrid.queryOverlaps(registry.bounds.get(humanoid).world, collisionCandidates);
+        for (std::uint32_t l : collisionCandidates)
+        {
+            landerNearHumanoid[l] = 1;
+        }
+    }
+
+    // a lander that touches no humanoid only acts on them if it is carrying one or was destroyed
+    for (std::size_t i = 0; i < registry.landers.size(); i++)
+    {
+        const LanderAI &ai = registry.landers[i];
+        if (landerNearHumanoid[i] || ai.captured || ai.destroyed)
+        {
+            checkLanderHumanoidCollisions(registry.landers.getEntity(i));
+        }
+    }
+}
+
+void Simulation::checkPlayerHumanoidCollision(float deltaTime)
+{
+    for (std::size_t i = 0; i < registry.humanoids.size(); i++)
+    {
+        Entity humanoid = registry.humanoids.getEntity(i);
+        HumanoidAI &ai = registry.humanoids[i];
+        const Transform &transform = registry.transforms.get(humanoid);
+        if (ai.falling && transform.position.y != WINDOW_HEIGHT - 50 &&
+            masksOverlap(player.getPlayerBounds(), &player.getPlayerMask(), registry.bounds.get(humanoid).world, registry.colliders.get(humanoid).mask))
+        {
+            captureHumanoid(registry, humanoid, player.getPlayerPosition());
+            player.setHumanoidCaptured(true);
+            ai.playerCaptured = true;
+            updateHumanoid(registry, humanoid, numHumanoids, deltaTime);
+        }
+        else if (player.getPlayerPosition().y >= WINDOW_HEIGHT - 200 && player.isHumanoidCaptured() && ai.playerCaptured)
+        {
+            depositHumanoid(registry, humanoid, player.getPlayerPosition().x);
+            player.setHumanoidCaptured(false);
+            ai.playerCaptured = false;
+            updateHumanoid(registry, humanoid, numHumanoids, deltaTime);
+        }
+    }
+}
+
+#ifdef FRAME_PROFILER
+void Simulation::setProfiler(FrameProfiler *profiler)
+{
+    this->profiler = profiler;
+}
+#endif
+
+const SimConfig &Simulation::getConfig() const
+{
+    return config;
+}
+
+const SimEvents &Simulation::getEvents() const
+{
+    return events;
+}
+
+bool Simulation::isGameOver() const
+{
+    return gameOver;
+}
+
+bool Simulation::isGameWon() const
+{
+    return gameWon;
+}
+
+bool Simulation::areAllHumanoidsDead() const
+{
+    return allHumanoidsDead;
+}
+
+bool Simulation::isOutOfFuel() const
+{
+    return outOfFuel;
+}
+
+bool Simulation::isShieldOn() const
+{
+    return shieldOn;
+}
+
+int Simulation::getScore() const
+{
+    return score;
+}
+
+int Simulation::getNumLives() const
+{
+    return numLives;
+}
+
+int Simulation::getNumShields() const
+{
+    return numShields;
+}
+
+int Simulation::getNumHumanoids() const
+{
+    return numHumanoids;
+}
+
+int Simulation::getNumLandersDestroyed() const
+{
+    return numLandersDestroyed;
+}
@@ -0,0 +1,370 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "InputState.h"
+#include "player.h"
+#include "ProjectileStore.h"
+#include "Registry.h"
+#include "Random.h"
+#include "SpatialGrid.h"
+#include "TargetIndex.h"
+#include "TimerWheel.h"
+#include "WorkerPool.h"
+#include "CollisionSystem.h"
+
+class FrameProfiler;
+
+// initialise constant global variables
+const int WINDOW_WIDTH = 1600;
+const int WINDOW_HEIGHT = 900;
+const float PLAYER_SPEED = 300.0f; // pixels per second
+const float LASER_COOLDOWN = 0.5f;
+const float SIM_TIME_STEP = 1.0f / 120.0f; // the simulation always advances in steps of this many seconds
+const float PROJECTILE_CULL_MARGIN = 300.0f; // how far past the screen edges lasers and missiles may fly
+const float COLLISION_CELL_SIZE = 128.0f;    // width and height of a broadphase grid cell, a few landers across
+
+/**
+ * @struct SimConfig
+ * @brief Start-up settings for a Simulation.
+ */
+struct SimConfig
+{
+    unsigned int seed = 1;       /**< Seed for every random stream in the simulation. */
+    int maxLanders = 11;         /**< Number of landers spawned over a game; destroying them all wins it. */
+    int maxHumanoids = 5;        /**< Number of humanoids spawned over a game. */
+    unsigned int numThreads = 0; /**< Threads that run the lander AI, 0 for one per core; any number plays the same game. */
+};
+
+/**
+ * @struct SimEvents
+ * @brief What happened during the last simulation update, so the Game can play the matching sounds.
+ */
+struct SimEvents
+{
+    bool laserFired = false;      /**< The player fired a laser. */
+    bool landerDestroyed = false; /**< A laser destroyed a lander. */
+    bool humanoidKilled = false;  /**< A laser killed a humanoid. */
+    bool playerHit = false;       /**< A lander or missile hit the player. */
+    bool shieldRaised = false;    /**< The player raised the shield. */
+    bool fuelCollected = false;   /**< The player picked up the fuel can. */
+};
+
+/**
+ * @class Simulation
+ * @brief The game world without a window: movement, spawning, collisions, score and lives.
+ *
+ * The Game owns a Simulation and draws it, while the headless runner steps one on its own to
+ * measure how fast the game logic runs.
+ */
+class Simulation
+{
+public:
+    /**
+     * @brief Construct a new Simulation object.
+     *
+     * @param config The seed and entity caps to run with.
+     */
+    explicit Simulation(const SimConfig &config = SimConfig());
+
+    /**
+     * @brief Advance the simulation by one update.
+     *
+     * The Game always passes SIM_TIME_STEP so the game plays the same at any frame rate.
+     *
+     * @param deltaTime The time passed since the last update, in seconds.
+     * @param input The controls held down for this update.
+     */
+    void update(float deltaTime, const InputState &input);
+
+    /**
+     * @brief Reset the simulation to the start of a new game.
+     */
+    void reset();
+
+    /**
+     * @brief Spawn a lander, unless the lander cap has been reached.
+     */
+    void spawnLander();
+
+    /**
+     * @brief Spawn a humanoid at the bottom of the screen, unless the humanoid cap has been reached.
+     */
+    void spawnHumanoids();
+
+    /**
+     * @brief Get the settings the simulation was started with.
+     *
+     * @return The simulation settings.
+     */
+    const SimConfig &getConfig() const;
+
+    /**
+     * @brief Get what happened during the last update.
+     *
+     * @return The events of the last update.
+     */
+    const SimEvents &getEvents() const;
+
+    /**
+     * @brief Check if the game has ended, either won or lost.
+     *
+     * @return True if the game is over, false otherwise.
+     */
+    bool isGameOver() const;
+
+    /**
+     * @brief Check if the game was won.
+     *
+     * @return True if the game is won, false otherwise.
+     */
+    bool isGameWon() const;
+
+    /**
+     * @brief Check if all the humanoids were killed.
+     *
+     * @return True if all humanoids are dead, false otherwise.
+     */
+    bool areAllHumanoidsDead() const;
+
+    /**
+     * @brief Check if the game ended because the player ran out of fuel.
+     *
+     * @return True if the player is out of fuel, false otherwise.
+     */
+    bool isOutOfFuel() const;
+
+    /**
+     * @brief Check if the player's shield is up.
+     *
+     * @return True if the shield is on, false otherwise.
+     */
+    bool isShieldOn() const;
+
+    /**
+     * @brief Get the player's score.
+     *
+     * @return The current score.
+     */
+    int getScore() const;
+
+    /**
+     * @brief Get the number of lives the player has left.
+     *
+     * @return The number of lives.
+     */
+    int getNumLives() const;
+
+    /**
+     * @brief Get the number of shields the player has left.
+     *
+     * @return The number of shields.
+     */
+    int getNumShields() const;
+
+    /**
+     * @brief Get the number of humanoids still alive.
+     *
+     * @return The number of living humanoids.
+     */
+    int getNumHumanoids() const;
+
+    /**
+     * @brief Get the number of landers destroyed.
+     *
+     * @return The number of landers destroyed.
+     */
+    int getNumLandersDestroyed() const;
+
+    /**
+     * @brief Check collisions between a lander and the humanoids, capturing or releasing them.
+     *
+     * @param lander The lander to check.
+     */
+    void checkLanderHumanoidCollisions(Entity lander);
+
+    /**
+     * @brief Check collisions between every lander and the humanoids.
+     *
+     * A grid of the landers finds the few near a humanoid. Only those, and the landers carrying a
+     * humanoid or destroyed this update, get the full check, so the result is the same as checking
+     * every lander in turn.
+     */
+    void checkLanderHumanoidCollisions();
+
+#ifdef FRAME_PROFILER
+    /**
+     * @brief Time the lander, collision and missile phases of each update.
+     *
+     * @param profiler The profiler to add the phase times to, or nullptr to stop timing.
+     */
+    void setProfiler(FrameProfiler *profiler);
+#endif
+
+    Player player;
+    ProjectileStore projectiles;
+    Registry registry; /**< The landers and humanoids. */
+
+private:
+    /**
+     * @brief Spawn missiles from active landers.
+     */
+    void spawnMissilesFromLanders();
+
+    /**
+     * @brief Schedule the next lander to spawn, which schedules the one after it in turn.
+     */
+    void scheduleLanderSpawn();
+
+    /**
+     * @brief Schedule the landers' next missile volley, which schedules the one after it in turn.
+     */
+    void scheduleMissileSpawn();
+
+    /**
+     * @brief Schedule the spawns and the fuel can, and start the shield, the laser and the hit cooldowns out pending, as at the start of a game.
+     */
+    void startTimers();
+
+    /**
+     * @brief Remember every entity's position so the Game can draw between the last two updates.
+     */
+    void savePreviousPositions();
+
+    /**
+     * @brief Update humanoid movement and check whether they have all died.
+     *
+     * @param deltaTime The time passed since the last update, in seconds.
+     */
+    void updateHumanoids(float deltaTime);
+
+    /**
+     * @brief Find what each laser and missile hit, queueing a CollisionEvent for resolveCollisions().
+     *
+     * Each projectile is swept from where it was to where it is and tested only against the layers
+     * in its collision mask, and reports whatever it reached first.
+     *
+     * @param deltaTime The time passed since the last update, in seconds.
+     */
+    void detectProjectileCollisions(float deltaTime);
+
+    /**
+     * @brief Sweep one projectile against every layer its layer goes looking for, and queue what it hit first.
+     *
+     * @param index The projectile's index.
+     */
+    template <std::uint8_t Layer>
+    void detectProjectileCollision(std::size_t index);
+
+    /**
+     * @brief Sweep a projectile against the members of one layer, keeping the earliest hit so far.
+     *
+     * Each layer a projectile can hit has its own specialisation.
+     *
+     * @param index The projectile's index.
+     * @param sweptBounds The box covering the projectile's path this update.
+     * @param firstImpact The earliest time of impact so far, lowered if this layer has an earlier one.
+     * @param hit Set to the entity hit, or NO_ENTITY for the player, if this layer has an earlier one.
+     * @return True if this layer had the earliest hit so far, false otherwise.
+     */
+    template <std::uint8_t Target>
+    bool sweepLayer(std::size_t index, const sf::FloatRect &sweptBounds, float &firstImpact, Entity &hit);
+
+    /**
+     * @brief Queue a collision for every member of one layer a box overlaps, pixel for pixel.
+     *
+     * Each layer the player can run into has its own specialisation.
+     *
+     * @param layers The key of the pair being checked.
+     * @param bounds The box.
+     * @param mask The box's solid pixels, or nullptr if all of them are solid.
+     */
+    template <std::uint8_t Target>
+    void overlapLayer(std::uint8_t layers, const sf::FloatRect &bounds, const PixelMask *mask);
+
+    /**
+     * @brief Respond to every CollisionEvent queued this update, in the order they were found.
+     */
+    void resolveCollisions();
+
+    /**
+     * @brief Respond to one collision between two layers. Each pair in GameCollisions has its own specialisation.
+     *
+     * @param collision The collision.
+     */
+    template <std::uint8_t First, std::uint8_t Second>
+    void respond(const CollisionEvent &collision);
+
+    /**
+     * @brief Rebuild the grid of the landers' bounding boxes, by their place in the lander pool.
+     */
+    void buildLanderGrid();
+
+    /**
+     * @brief Rebuild the grid of the humanoids' bounding boxes, by their place in the humanoid pool.
+     */
+    void buildHumanoidGrid();
+
+    /**
+     * @brief Check the landers against the humanoids and queue the ones touching the player.
+     */
+    void checkLanderCollisions();
+
+    /**
+     * @brief Move the lasers and missiles.
+     *
+     * @param deltaTime The time passed since the last update, in seconds.
+     */
+    void updateProjectiles(float deltaTime);
+
+    /**
+     * @brief Remove the landers and humanoids destroyed this update from the registry.
+     */
+    void removeDestroyedEntities();
+
+    /**
+     * @brief Check collisions between the player and humanoids.
+     *
+     * @param deltaTime The time passed since the last update, in seconds.
+     */
+    void checkPlayerHumanoidCollision(float deltaTime);
+
+    SimConfig config;
+    SimEvents events;
+    int score;
+    int numLives;
+    int numShields;
+    int numHumanoids;
+    int totalLandersSpawned;
+    int numLandersDestroyed;
+    int numHumanoidsInTotal;
+    std::uint64_t numUpdates; /**< Updates since the simulation started, which picks the far landers' turn to think. */
+    bool shieldOn;
+    bool gameOver;
+    bool gameWon;
+    bool allHumanoidsDead;
+    bool outOfFuel;
+    sf::Sprite landerSprite; /**< Shared by every lander's Renderable. */
+    sf::Sprite humanoidSprite; /**< Shared by every humanoid's Renderable. */
+    const PixelMask *landerMask;   /**< Shared by every lander's Collider. */
+    const PixelMask *humanoidMask; /**< Shared by every humanoid's Collider. */
+    Random humanoidRandom;
+    TimerWheel timers;       /**< Every spawn and cooldown, in simulation time. */
+    TimerId shieldTimer;     /**< Pending while the shield is up, and while it recharges at the start. */
+    TimerId missileHitTimer; /**< Pending while another missile cannot hurt the player. */
+    TimerId landerHitTimer;  /**< Pending while another lander cannot hurt the player. */
+    SpatialGrid landerGrid;
+    SpatialGrid humanoidGrid;
+    SpatialGrid flockGrid;       /**< The living landers as points, for flockLanders() to find neighbours in. */
+    TargetIndex humanoidTargets; /**< The living humanoids, for the landers to pick targets from. */
+    WorkerPool workers;          /**< The threads that run the lander AI. */
+    std::vector<std::uint32_t> collisionCandidates; /**< Reused by every grid query. */
+    std::vector<char> landerNearHumanoid;           /**< Per lander, whether a humanoid touches it. */
+    std::vector<std::uint64_t> projectileHits;      /**< The projectiles near the player, as a hit mask. */
+    std::vector<CollisionEvent> collisions;         /**< The pairs found this update, waiting for resolveCollisions(). */
+#ifdef FRAME_PROFILER
+    FrameProfiler *profiler = nullptr;
+#endif
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "SpatialGrid.h"
+#include "BatchIntersect.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(const sf::FloatRect &world, float cellSize)
+    : world(world), cellSize(cellSize),
+      numColumns(std::max(1, static_cast<int>(std::ceil(world.width / cellSize)))),
+      numRows(std::max(1, static_cast<int>(std::ceil(world.height / cellSize)))),
+      cellStarts(numColumns * numRows + 1, 0)
+{
+}
+
+void SpatialGrid::clear()
+{
+    entries.clear();
+}
+
+void SpatialGrid::insert(std::uint32_t id, const sf::FloatRect &bounds)
+{
+    int left, top, right, bottom;
+    getCellRange(bounds, left, top, right, bottom);
+    for (int row = top; row <= bottom; row++)
+    {
+        for (int column = left; column <= right; column++)
+        {
+            entries.push_back({static_cast<std::uint32_t>(row * numColumns + column), id, bounds});
+        }
+    }
+}
+
+void SpatialGrid::build()
+{
+    // this is a counting sort: count the boxes in each cell, then place each id after the cells before it
+    std::fill(cellStarts.begin(), cellStarts.end(), 0);
+    for (const Entry &entry : entries)
+    {
+        cellStarts[entry.cell + 1]++;
+    }
+    for (std::size_t cell = 1; cell < cellStarts.size(); cell++)
+    {
+        cellStarts[cell] += cellStarts[cell - 1];
+    }
+
+    cellItems.resize(entries.size());
+    cellLefts.resize(entries.size());
+    cellTops.resize(entries.size());
+    cellWidths.resize(entries.size());
+    cellHeights.resize(entries.size());
+    for (const Entry &entry : entries)
+    {
+        // cellStarts[cell] is used as the next free place and ends up at the cell's end, the next cell's start
+        std::uint32_t place = cellStarts[entry.cell]++;
+        cellItems[place] = entry.id;
+        cellLefts[place] = entry.bounds.left;
+        cellTops[place] = entry.bounds.top;
+        cellWidths[place] = entry.bounds.width;
+        cellHeights[place] = entry.bounds.height;
+    }
+    for (std::size_t cell = cellStarts.size() - 1; cell > 0; cell--)
+    {
+        cellStarts[cell] = cellStarts[cell - 1];
+    }
+    cellStarts[0] = 0;
+}
+
+void SpatialGrid::queryOverlaps(const sf::FloatRect &bounds, std::vector<std::uint32_t> &overlaps) const
+{
+    overlaps.clear();
+    int left, top, right, bottom;
+    getCellRange(bounds, left, top, right, bottom);
+    for (int row = top; row <= bottom; row++)
+    {
+        for (int column = left; column <= right; column++)
+        {
+            int cell = row * numColumns + column;
+            std::size_t start = cellStarts[cell];
+            std::size_t count = cellStarts[cell + 1] - start;
+            hitWords.resize(std::max(hitWords.size(), getNumHitWords(count)));
+            intersectBoxes(bounds, cellLefts.data() + start, cellTops.data() + start, cellWidths.data() + start, cellHeights.data() + start, count, hitWords.data());
+
+            for (std::size_t word = 0; word < getNumHitWords(count); word++)
+            {
+                for (std::uint64_t hits = hitWords[word]; hits != 0; hits &= hits - 1)
+                {
+                    overlaps.push_back(cellItems[start + word * 64 + getLowestHit(hits)]);
+                }
+            }
+        }
+    }
+
+    // a box that spans several cells is found once per cell
+    std::sort(overlaps.begin(), overlaps.end());
+    overlaps.erase(std::unique(overlaps.begin(), overlaps.end()), overlaps.end());
+}
+
+std::size_t SpatialGrid::getNumCells() const
+{
+    return static_cast<std::size_t>(numColumns) * numRows;
+}
+
+void SpatialGrid::getCellRange(const sf::FloatRect &bounds, int &left, int &top, int &right, int &bottom) const
+{
+    auto toCell = [this](float coordinate, float origin, int numCells)
+    {
+        float cell = std::floor((coordinate - origin) / cellSize);
+        return static_cast<int>(std::min(std::max(cell, 0.0f), static_cast<float>(numCells - 1)));
+    };
+    left = toCell(bounds.left, world.left, numColumns);
+    right = toCell(bounds.left + bounds.width, world.left, numColumns);
+    top = toCell(bounds.top, world.top, numRows);
+    bottom = toCell(bounds.top + bounds.height, world.top, numRows);
+}
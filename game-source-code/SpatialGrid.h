@@ -0,0 +1,129 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SpatialGrid
+ * @brief A uniform grid of square cells that finds which boxes might overlap a query box.
+ *
+ * Each update the boxes of one kind of entity are inserted with an id, such as their place in a
+ * component pool, and build() packs them cell by cell into one array. A query then only looks at
+ * the cells it covers instead of every box. Boxes outside the world are kept in the edge cells, so
+ * nothing is ever missed, only found less cheaply. Each cell's boxes are also packed side by side,
+ * so queryOverlaps() can test them several at a time.
+ */
+class SpatialGrid
+{
+public:
+    /**
+     * @brief Construct a new, empty SpatialGrid object.
+     *
+     * @param world The area the cells cover.
+     * @param cellSize The width and height of a cell in pixels.
+     */
+    SpatialGrid(const sf::FloatRect &world, float cellSize);
+
+    /**
+     * @brief Remove every box, keeping the memory for the next ones.
+     */
+    void clear();
+
+    /**
+     * @brief Add a box to every cell it overlaps. It is not found by queries until build() is called.
+     *
+     * @param id What the box belongs to.
+     * @param bounds The box.
+     */
+    void insert(std::uint32_t id, const sf::FloatRect &bounds);
+
+    /**
+     * @brief Sort the boxes inserted since clear() into their cells.
+     */
+    void build();
+
+    /**
+     * @brief Find the boxes that overlap a query box, testing each cell's boxes with intersectBoxes().
+     *
+     * Not safe to call from two threads at once, as the hit masks share one buffer.
+     *
+     * @param bounds The query box.
+     * @param overlaps Filled with the ids of the boxes that overlap it, in increasing order and each only once.
+     */
+    void queryOverlaps(const sf::FloatRect &bounds, std::vector<std::uint32_t> &overlaps) const;
+
+    /**
+     * @brief Call a visitor with every box in the cells a query box overlaps, cell by cell, until it returns false.
+     *
+     * Nothing is sorted or tested, and a box that spans several cells is visited once per cell, so
+     * this suits boxes inserted as points, such as neighbour searches. Safe to call from several
+     * threads at once.
+     *
+     * @param bounds The query box.
+     * @param visit Called with each box's id and top left corner; returns false to stop early.
+     */
+    template <typename Visitor>
+    void forEachInCells(const sf::FloatRect &bounds, Visitor visit) const;
+
+    /**
+     * @brief Get the number of cells.
+     *
+     * @return The number of cells.
+     */
+    std::size_t getNumCells() const;
+
+private:
+    /**
+     * @brief Get the cells a box overlaps, clamped to the grid.
+     */
+    void getCellRange(const sf::FloatRect &bounds, int &left, int &top, int &right, int &bottom) const;
+
+    sf::FloatRect world;
+    float cellSize;
+    int numColumns;
+    int numRows;
+    /**
+     * @struct Entry
+     * @brief A box inserted into one cell.
+     */
+    struct Entry
+    {
+        std::uint32_t cell;
+        std::uint32_t id;
+        sf::FloatRect bounds;
+    };
+
+    std::vector<Entry> entries;            /**< Every inserted box, once for each cell it overlaps. */
+    std::vector<std::uint32_t> cellStarts; /**< Where each cell's ids start in cellItems, plus the end. */
+    std::vector<std::uint32_t> cellItems;  /**< The ids, grouped by cell. */
+    std::vector<float> cellLefts;          /**< The boxes of cellItems, packed for intersectBoxes(). */
+    std::vector<float> cellTops;
+    std::vector<float> cellWidths;
+    std::vector<float> cellHeights;
+    mutable std::vector<std::uint64_t> hitWords; /**< The hit mask of the cell queryOverlaps() is testing. */
+};
+
+template <typename Visitor>
+void SpatialGrid::forEachInCells(const sf::FloatRect &bounds, Visitor visit) const
+{
+    int left, top, right, bottom;
+    getCellRange(bounds, left, top, right, bottom);
+    for (int row = top; row <= bottom; row++)
+    {
+        for (int column = left; column <= right; column++)
+        {
+            int cell = row * numColumns + column;
+            for (std::uint32_t place = cellStarts[cell]; place < cellStarts[cell + 1]; place++)
+            {
+                if (!visit(cellItems[place], sf::Vector2f(cellLefts[place], cellTops[place])))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+#endif
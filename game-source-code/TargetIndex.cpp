@@ -0,0 +1,84 @@
+#include "TargetIndex.h"
+#include <algorithm>
+#include <cmath>
+
+void TargetIndex::clear()
+{
+    targets.clear();
+}
+
+void TargetIndex::insert(std::uint32_t id, const sf::Vector2f &position)
+{
+    targets.push_back({position.x, position.y, id});
+}
+
+void TargetIndex::build()
+{
+    std::sort(targets.begin(), targets.end(), [](const Target &a, const Target &b)
+              { return a.x < b.x || (a.x == b.x && a.id < b.id); });
+    top = targets.empty() ? 0.0f : targets[0].y;
+    bottom = top;
+    for (const Target &target : targets)
+    {
+        top = std::min(top, target.y);
+        bottom = std::max(bottom, target.y);
+    }
+}
+
+void TargetIndex::remove(std::uint32_t id, const sf::Vector2f &position)
+{
+    Target key = {position.x, position.y, id};
+    auto found = std::lower_bound(targets.begin(), targets.end(), key, [](const Target &a, const Target &b)
+                                  { return a.x < b.x || (a.x == b.x && a.id < b.id); });
+    if (found != targets.end() && found->id == id)
+    {
+        targets.erase(found);
+    }
+}
+
+std::size_t TargetIndex::size() const
+{
+    return targets.size();
+}
+
+std::uint32_t TargetIndex::findNearest(const sf::Vector2f &position, float maxDistance) const
+{
+    float nearest = maxDistance;
+    std::uint32_t found = NO_TARGET;
+    // no target is nearer vertically than this, so it is added to every horizontal gap
+    float minGapY = std::max(0.0f, std::max(top - position.y, position.y - bottom));
+    auto consider = [&](const Target &target)
+    {
+        float distance = std::abs(target.x - position.x) + std::abs(target.y - position.y);
+        if (distance < nearest || (distance == nearest && found != NO_TARGET && target.id < found))
+        {
+            nearest = distance;
+            found = target.id;
+        }
+    };
+
+    // this is the first target at or right of the position; targets further out along x only get further away
+    std::size_t start = 0;
+    std::size_t end = targets.size();
+    while (start < end)
+    {
+        std::size_t middle = (start + end) / 2;
+        if (targets[middle].x < position.x)
+        {
+            start = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    for (std::size_t i = start; i < targets.size() && targets[i].x - position.x + minGapY <= nearest; i++)
+    {
+        consider(targets[i]);
+    }
+    for (std::size_t i = start; i > 0 && position.x - targets[i - 1].x + minGapY <= nearest; i--)
+    {
+        consider(targets[i - 1]);
+    }
+    return found;
+}
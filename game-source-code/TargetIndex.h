@@ -0,0 +1,86 @@
+#ifndef TARGETINDEX_H
+#define TARGETINDEX_H
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+const std::uint32_t NO_TARGET = 0xFFFFFFFFu; // returned when no target is in reach
+
+/**
+ * @class TargetIndex
+ * @brief Points sorted left to right, which finds the nearest one to a position without checking them all.
+ *
+ * Each update the targets, such as the humanoids, are inserted with an id and build() sorts them.
+ * A query starts at the position's place in the sorted order and walks outwards both ways, and
+ * stops as soon as the horizontal gap plus the smallest vertical gap any target could have is
+ * larger than the nearest distance found, so most targets are never looked at. Distances are
+ * measured along the axes, |dx| + |dy|. Targets that can take no more, such as a humanoid with
+ * enough landers after it, are removed rather than rejected, since a rejected target is still
+ * walked past by every later query.
+ */
+class TargetIndex
+{
+public:
+    /**
+     * @brief Remove every target, keeping the memory for the next ones.
+     */
+    void clear();
+
+    /**
+     * @brief Add a target. It is not found by queries until build() is called.
+     *
+     * @param id What the target belongs to.
+     * @param position Where the target is.
+     */
+    void insert(std::uint32_t id, const sf::Vector2f &position);
+
+    /**
+     * @brief Sort the targets inserted since clear().
+     */
+    void build();
+
+    /**
+     * @brief Take a built target out, so later queries do not have to walk past it.
+     *
+     * @param id What the target belongs to.
+     * @param position Where the target was inserted.
+     */
+    void remove(std::uint32_t id, const sf::Vector2f &position);
+
+    /**
+     * @brief Find the nearest target.
+     *
+     * Of targets equally near, the one with the smallest id is found, so the result does not
+     * depend on the order they were inserted in.
+     *
+     * @param position Where to search from.
+     * @param maxDistance Only targets nearer than this are found.
+     * @return The id of the nearest target, or NO_TARGET if there is none in reach.
+     */
+    std::uint32_t findNearest(const sf::Vector2f &position, float maxDistance) const;
+
+    /**
+     * @brief Get the number of targets.
+     *
+     * @return The number of targets.
+     */
+    std::size_t size() const;
+
+private:
+    /**
+     * @struct Target
+     * @brief One inserted target.
+     */
+    struct Target
+    {
+        float x;
+        float y;
+        std::uint32_t id;
+    };
+
+    std::vector<Target> targets; /**< Sorted by x once built. */
+    float top = 0.0f;            /**< The smallest y of any target. */
+    float bottom = 0.0f;         /**< The largest y of any target. */
+};
+
+#endif
@@ -0,0 +1,192 @@
+#include "TimerWheel.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+const double TICKS_PER_SECOND = 1000.0;
+const double TICK_ROUNDING = 1e-3; // of a tick; sums of float time steps can fall just short of a whole tick
+const int NUM_LEVELS = 4;
+const int SLOT_BITS = 6;
+const std::uint64_t SLOTS_PER_LEVEL = 1u << SLOT_BITS;
+const std::uint64_t SLOT_MASK = SLOTS_PER_LEVEL - 1;
+const std::uint64_t MAX_REACH = std::uint64_t(1) << (SLOT_BITS * NUM_LEVELS); // ticks the top level reaches
+const std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+const std::uint32_t NO_NEXT = 0xFFFFFFFFu;
+
+TimerWheel::TimerWheel()
+    : time(0.0), now(0), numPending(0), slots(NUM_LEVELS * SLOTS_PER_LEVEL, {NO_NEXT, NO_NEXT})
+{
+}
+
+TimerId TimerWheel::schedule(float delay, Callback callback)
+{
+    std::uint32_t timer;
+    if (freeTimers.empty())
+    {
+        timer = static_cast<std::uint32_t>(timers.size());
+        timers.push_back({Callback(), 0, 1, NO_SLOT, NO_NEXT, NO_NEXT});
+    }
+    else
+    {
+        timer = freeTimers.back();
+        freeTimers.pop_back();
+    }
+
+    std::uint64_t delayTicks = static_cast<std::uint64_t>(std::max(1.0, std::round(delay * TICKS_PER_SECOND)));
+    timers[timer].callback = std::move(callback);
+    timers[timer].due = now + delayTicks;
+    insert(timer);
+    numPending++;
+    return (static_cast<TimerId>(timers[timer].generation) << 32) | timer;
+}
+
+bool TimerWheel::cancel(TimerId timer)
+{
+    if (!isPending(timer))
+    {
+        return false;
+    }
+    std::uint32_t index = static_cast<std::uint32_t>(timer);
+    unlink(index);
+    timers[index].callback = nullptr;
+    timers[index].generation++;
+    freeTimers.push_back(index);
+    numPending--;
+    return true;
+}
+
+void TimerWheel::clear()
+{
+    for (std::uint32_t timer = 0; timer < timers.size(); timer++)
+    {
+        if (timers[timer].slot != NO_SLOT)
+        {
+            timers[timer].slot = NO_SLOT;
+            timers[timer].callback = nullptr;
+            timers[timer].generation++;
+            freeTimers.push_back(timer);
+        }
+    }
+    std::fill(slots.begin(), slots.end(), Slot{NO_NEXT, NO_NEXT});
+    numPending = 0;
+}
+
+bool TimerWheel::isPending(TimerId timer) const
+{
+    std::uint32_t index = static_cast<std::uint32_t>(timer);
+    return index < timers.size() && timers[index].generation == static_cast<std::uint32_t>(timer >> 32) &&
+           timers[index].slot != NO_SLOT;
+}
+
+void TimerWheel::advance(float deltaTime)
+{
+    time += deltaTime;
+    std::uint64_t target = static_cast<std::uint64_t>(std::floor(time * TICKS_PER_SECOND + TICK_ROUNDING));
+    while (now < target)
+    {
+        tick();
+    }
+}
+
+std::size_t TimerWheel::getNumPending() const
+{
+    return numPending;
+}
+
+void TimerWheel::insert(std::uint32_t timer)
+{
+    // a timer further off than the wheel reaches waits in the top level's last slot and is placed again from there
+    std::uint64_t due = std::min(timers[timer].due, now + MAX_REACH - 1);
+    std::uint64_t ticksLeft = due - now;
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && ticksLeft >= (std::uint64_t(1) << (SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+    std::uint32_t slot = static_cast<std::uint32_t>(level * SLOTS_PER_LEVEL + ((due >> (SLOT_BITS * level)) & SLOT_MASK));
+
+    Timer &placed = timers[timer];
+    placed.slot = slot;
+    placed.previous = slots[slot].last;
+    placed.next = NO_NEXT;
+    if (slots[slot].last == NO_NEXT)
+    {
+        slots[slot].first = timer;
+    }
+    else
+    {
+        timers[slots[slot].last].next = timer;
+    }
+    slots[slot].last = timer;
+}
+
+void TimerWheel::unlink(std::uint32_t timer)
+{
+    Timer &removed = timers[timer];
+    Slot &slot = slots[removed.slot];
+    if (removed.previous == NO_NEXT)
+    {
+        slot.first = removed.next;
+    }
+    else
+    {
+        timers[removed.previous].next = removed.next;
+    }
+    if (removed.next == NO_NEXT)
+    {
+        slot.last = removed.previous;
+    }
+    else
+    {
+        timers[removed.next].previous = removed.previous;
+    }
+    removed.slot = NO_SLOT;
+}
+
+void TimerWheel::cascade(int level, std::uint64_t index)
+{
+    Slot &slot = slots[level * SLOTS_PER_LEVEL + index];
+    std::uint32_t timer = slot.first;
+    slot.first = NO_NEXT;
+    slot.last = NO_NEXT;
+    while (timer != NO_NEXT)
+    {
+        std::uint32_t next = timers[timer].next;
+        insert(timer);
+        timer = next;
+    }
+}
+
+void TimerWheel::tick()
+{
+    now++;
+
+    // this finds the levels whose next span begins on this tick, which are the ones every level below
+    // has just come round for, and moves that span's timers down, highest level first
+    int level = 1;
+    while (level < NUM_LEVELS && (now & ((std::uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0)
+    {
+        level++;
+    }
+    for (level--; level > 0; level--)
+    {
+        cascade(level, (now >> (SLOT_BITS * level)) & SLOT_MASK);
+    }
+
+    // a callback can cancel a timer due on the same tick, so the slot is emptied one timer at a time
+    Slot &due = slots[now & SLOT_MASK];
+    while (due.first != NO_NEXT)
+    {
+        std::uint32_t timer = due.first;
+        unlink(timer);
+        Callback callback = std::move(timers[timer].callback);
+        timers[timer].callback = nullptr;
+        timers[timer].generation++;
+        freeTimers.push_back(timer);
+        numPending--;
+        if (callback)
+        {
+            callback();
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief A handle to a scheduled timer. Handles are never reused, so an old one is simply not pending.
+ */
+typedef std::uint64_t TimerId;
+
+const TimerId NO_TIMER = 0; // never a pending timer, for a handle that has not been scheduled yet
+
+/**
+ * @class TimerWheel
+ * @brief Callbacks scheduled in simulation time, kept in a hierarchical timer wheel.
+ *
+ * Time moves in ticks of one millisecond, and only when the owner advances it by each update's
+ * time step, so timers wait the same simulated time however fast the updates are run, and not
+ * at all while the game is paused. The wheel has four levels of 64 slots: the first holds the
+ * timers due in the next 64 ticks one slot per tick, and each level above holds 64 times longer
+ * spans, which are moved down a level as their time comes near. Scheduling, cancelling and firing
+ * a timer are all O(1), however many are pending. Timers further off than the top level reaches,
+ * about four and a half hours, wait in its last slot and are placed again when it comes round.
+ */
+class TimerWheel
+{
+public:
+    /**
+     * @brief What a timer does when it fires.
+     */
+    typedef std::function<void()> Callback;
+
+    /**
+     * @brief Construct a new TimerWheel object at time zero with no timers.
+     */
+    TimerWheel();
+
+    /**
+     * @brief Schedule a callback.
+     *
+     * @param delay The simulation time to wait, in seconds, rounded to the nearest tick but at least one.
+     * @param callback What to do when the timer fires. It may schedule and cancel timers, including
+     * rescheduling itself. An empty callback makes a timer that only marks a cooldown as pending.
+     * @return The timer's handle.
+     */
+    TimerId schedule(float delay, Callback callback);
+
+    /**
+     * @brief Stop a timer from firing.
+     *
+     * @param timer The timer's handle.
+     * @return True if the timer was pending, false if it had already fired or been cancelled.
+     */
+    bool cancel(TimerId timer);
+
+    /**
+     * @brief Cancel every pending timer. Time carries on from where it was, and old handles stay stale.
+     */
+    void clear();
+
+    /**
+     * @brief Check whether a timer is still waiting to fire.
+     *
+     * @param timer The timer's handle, or NO_TIMER.
+     * @return True if the timer is pending, false otherwise.
+     */
+    bool isPending(TimerId timer) const;
+
+    /**
+     * @brief Move time forward and fire every timer that falls due, in the order they fall due.
+     *
+     * @param deltaTime The simulation time that passed, in seconds.
+     */
+    void advance(float deltaTime);
+
+    /**
+     * @brief Get the number of pending timers.
+     *
+     * @return The number of pending timers.
+     */
+    std::size_t getNumPending() const;
+
+private:
+    /**
+     * @brief Put a timer in the slot for its due tick, on the lowest level that reaches it.
+     */
+    void insert(std::uint32_t timer);
+
+    /**
+     * @brief Take a timer out of its slot.
+     */
+    void unlink(std::uint32_t timer);
+
+    /**
+     * @brief Move one slot's timers down to the levels below, now that its span has begun.
+     */
+    void cascade(int level, std::uint64_t index);
+
+    /**
+     * @brief Move time on by one tick and fire the timers due on it.
+     */
+    void tick();
+
+    /**
+     * @struct Timer
+     * @brief One timer, linked into its slot's list by place in timers.
+     */
+    struct Timer
+    {
+        Callback callback;
+        std::uint64_t due;       /**< The tick it fires on. */
+        std::uint32_t generation; /**< Bumped every time the timer is freed, so old handles go stale. */
+        std::uint32_t slot;       /**< The slot it is in, or NO_SLOT if it is not pending. */
+        std::uint32_t previous;
+        std::uint32_t next;
+    };
+
+    /**
+     * @struct Slot
+     * @brief The first and last timer in a slot, so timers due together fire in the order they were placed.
+     */
+    struct Slot
+    {
+        std::uint32_t first;
+        std::uint32_t last;
+    };
+
+    double time;       /**< Seconds advanced in total; a double so long games don't lose precision. */
+    std::uint64_t now; /**< The last tick that has fired. */
+    std::size_t numPending;
+    std::vector<Timer> timers;
+    std::vector<std::uint32_t> freeTimers;
+    std::vector<Slot> slots; /**< Every level's slots, one level after another. */
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned int numThreads)
+{
+    if (numThreads == 0)
+    {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // the caller is one of the threads, so only the others are started
+    for (unsigned int i = 1; i < numThreads; i++)
+    {
+        threads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(std::size_t count, std::size_t minPerThread, const Task &task)
+{
+    std::size_t chunks = std::min(threads.size() + 1, (count + minPerThread - 1) / std::max<std::size_t>(minPerThread, 1));
+    if (chunks <= 1)
+    {
+        if (count > 0)
+        {
+            task(0, count);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        taskCount = count;
+        numChunks = chunks;
+        nextChunk = 0;
+        numChunksDone = 0;
+        generation++;
+    }
+    wake.notify_all();
+    runChunks();
+
+    // this waits for every chunk, and for every thread to let go of the task before it goes out of scope
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]()
+                  { return numChunksDone == numChunks && numBusy == 0; });
+    this->task = nullptr;
+}
+
+unsigned int WorkerPool::getNumThreads() const
+{
+    return static_cast<unsigned int>(threads.size() + 1);
+}
+
+void WorkerPool::runChunks()
+{
+    for (std::size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+    {
+        (*task)(chunk * taskCount / numChunks, (chunk + 1) * taskCount / numChunks);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        numChunksDone++;
+        finished.notify_one();
+    }
+}
+
+void WorkerPool::work()
+{
+    std::uint64_t lastGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]()
+                      { return stopping || generation != lastGeneration; });
+            if (stopping)
+            {
+                return;
+            }
+            lastGeneration = generation;
+            // a thread that wakes after the task it was woken for has finished has nothing to do
+            if (task == nullptr)
+            {
+                continue;
+            }
+            numBusy++;
+        }
+
+        runChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        numBusy--;
+        finished.notify_one();
+    }
+}
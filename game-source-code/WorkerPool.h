@@ -0,0 +1,87 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkerPool
+ * @brief A fixed set of threads that share out a loop over a range of indices.
+ *
+ * The range is cut into one contiguous chunk per thread, so each index is always handled by
+ * exactly one call and, as long as each call only writes what belongs to its own indices, the
+ * result does not depend on how many threads there are or which one runs which chunk. The
+ * calling thread works on the chunks too, so a pool of one thread runs everything in place.
+ */
+class WorkerPool
+{
+public:
+    /**
+     * @brief A piece of work over the indices from begin up to, but not including, end.
+     */
+    typedef std::function<void(std::size_t begin, std::size_t end)> Task;
+
+    /**
+     * @brief Construct a new WorkerPool object and start its threads.
+     *
+     * @param numThreads The number of threads that work, counting the caller's; 0 uses one per core.
+     */
+    explicit WorkerPool(unsigned int numThreads = 0);
+
+    /**
+     * @brief Destroy the WorkerPool object, after its threads have finished.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /**
+     * @brief Run a task over a range of indices, split between the threads, and wait for it to finish.
+     *
+     * Small ranges are not worth waking the threads for, so they run in place on the caller.
+     *
+     * @param count The number of indices, starting at 0.
+     * @param minPerThread The fewest indices worth giving a thread of its own.
+     * @param task Called once per chunk, possibly at the same time as for other chunks.
+     */
+    void run(std::size_t count, std::size_t minPerThread, const Task &task);
+
+    /**
+     * @brief Get the number of threads that work, counting the caller's.
+     *
+     * @return The number of threads.
+     */
+    unsigned int getNumThreads() const;
+
+private:
+    /**
+     * @brief Take chunks of the current task until there are none left.
+     */
+    void runChunks();
+
+    /**
+     * @brief What each of the pool's own threads does until the pool is destroyed.
+     */
+    void work();
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;     /**< Signalled when a task starts or the pool stops. */
+    std::condition_variable finished; /**< Signalled when a chunk finishes or a thread stops working on a task. */
+    const Task *task = nullptr;       /**< The task being run, or nullptr between runs. */
+    std::size_t taskCount = 0;
+    std::size_t numChunks = 0;
+    std::atomic<std::size_t> nextChunk{0};
+    std::size_t numChunksDone = 0;
+    std::size_t numBusy = 0;          /**< How many of the pool's threads are working on the task. */
+    std::uint64_t generation = 0;     /**< Counts the tasks run, so a thread can tell a new one from the last. */
+    bool stopping = false;
+};
+
+#endif
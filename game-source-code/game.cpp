@@ -1,40 +1,35 @@
-#include "Game.h"
-#include "Player.h"
-#include "Laser.h"
-#include "Lander.h"
+#include "game.h"
+#include "ResourceCache.h"
+#include "FrameProfiler.h"
+#include "RenderSystem.h"
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <algorithm>
 #include <vector>
 #include <cmath>
-#include "Humanoid.h"
+#include <iomanip>
+#include <sstream>
 
 const float BACKGROUND_SCROLL_SPEED = 500.0f;
-const float LANDER_SPAWN_COOLDOWN = 1.5f;
-const int INITIAL_NUM_LIVES = 3;
-const int SHIELD_EFFECT_LENGTH = 5.0f;
 const int MINIMAP_WIDTH = 100.0f;
 const int MINIMAP_HEIGHT = 60.0f;
 const int BORDER_SIZE = 5.0f;
-const int LANDER_HEIGHT = 30.0f;
-const int MOVEMENT_SPEED = 2.0f;
-const int HUMANOID_HEIGHT = 30.0f;
-
-Game::Game()
-    : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Space Defender", sf::Style::Titlebar | sf::Style::Close), splashScreenDisplayed(false), spawnTimer(), lander(LANDER_SPAWN_COOLDOWN), score(0), numLives(3), numShields(3), numHumanoids(5), gameOver(false), shieldFrame(sf::Vector2f(player.getPlayerBounds().width + 10, player.getPlayerBounds().height + 10)),
-      shieldOn(false), isGameOverScreenDisplayed(false), gameWon(false), totalLandersSpawned(0), numLandersDestroyed(0), numHumanoidsInTotal(0), allHumanoidsDead(false), highScoreManager(), typingName(false)
+const float MAX_FRAME_TIME = 0.25f; // longer frames are clamped so a stall doesn't trigger hundreds of catch-up steps
+const char *const FRAME_TIMINGS_FILE = "frame_timings.csv";
+
+Game::Game(const std::string &recordingFile)
+    : accumulator(0.0f), window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Space Defender", sf::Style::Titlebar | sf::Style::Close), splashScreenDisplayed(false), gameOver(false), shieldFrame(sf::Vector2f(simulation.player.getPlayerBounds().width + 10, simulation.player.getPlayerBounds().height + 10)),
+      isGameActive(false), isGameOverScreenDisplayed(false), gameWon(false), allHumanoidsDead(false), highScoreManager(), font(getResourceCache().getFont("resources/INVASION2000.ttf")),
+      backgroundTexture(getResourceCache().getTexture("resources/space4.jpg")), typingName(false),
+      recording(simulation.getConfig()), recordingFile(recordingFile), isRecording(!recordingFile.empty())
 {
     shieldFrame.setOutlineThickness(5);
     shieldFrame.setOutlineColor(sf::Color::Blue);
     shieldFrame.setFillColor(sf::Color::Transparent);
 
-    newGameTimer.restart();
     frameClock.restart();
-    window.setFramerateLimit(60);
-    if (!font.loadFromFile("resources/INVASION2000.ttf"))
-    {
-        std::cerr << "Failed to load font file" << std::endl;
-    }
+    window.setVerticalSyncEnabled(true);
     scoreText.setFont(font);
     scoreText.setCharacterSize(24);
     scoreText.setFillColor(sf::Color::White);
@@ -60,39 +55,23 @@ Game::Game()
     humanoidText.setFillColor(sf::Color::White);
     humanoidText.setPosition(10, 100);
 
-    if (!backgroundTexture.loadFromFile("resources/space4.jpg"))
-    {
-        std::cerr << "Failed to load sidescroll.jpg" << std::endl;
-    }
-
-    if (!explosionBuffer.loadFromFile("resources/explosion.wav")) // the following are resources
-    {
-        std::cerr << "Failed to load gun.wav" << std::endl;
-    }
-    explosionSound.setBuffer(explosionBuffer);
-
-    if (!shieldBuffer.loadFromFile("resources/shield.mp3")) // the following are resources
-    {
-        std::cerr << "Failed to load gun.wav" << std::endl;
-    }
-    shieldSound.setBuffer(shieldBuffer);
-
-    if (!crashBuffer.loadFromFile("resources/player_hit.mp3")) // the following are resources
-    {
-        std::cerr << "Failed to load gun.wav" << std::endl;
-    }
-    crashSound.setBuffer(crashBuffer);
-
-    if (!HumanoidBuffer.loadFromFile("resources/humanoid_dead.wav")) // the following are resources
-    {
-        std::cerr << "Failed to load humanoid_dead.wav" << std::endl;
-    }
-    HumanoidSound.setBuffer(HumanoidBuffer);
-
-    if (!humanoidTexture.loadFromFile("resources/humanoid.png"))
-    {
-        std::cerr << "Failed to load humanoid texture!" << std::endl;
-    }
+#ifdef FRAME_PROFILER
+    simulation.setProfiler(&profiler);
+    showProfilerOverlay = false;
+    profilerText.setFont(font);
+    profilerText.setCharacterSize(16);
+    profilerText.setFillColor(sf::Color::Yellow);
+    profilerText.setPosition(10, 140);
+#endif
+
+    // this shares every sound buffer through the resource cache, so each file is only decoded once
+    ResourceCache &resources = getResourceCache();
+    explosionSound.setBuffer(resources.getSoundBuffer("resources/explosion.wav"));
+    shieldSound.setBuffer(resources.getSoundBuffer("resources/shield.mp3"));
+    crashSound.setBuffer(resources.getSoundBuffer("resources/player_hit.mp3"));
+    HumanoidSound.setBuffer(resources.getSoundBuffer("resources/humanoid_dead.wav"));
+    laserSound.setBuffer(resources.getSoundBuffer("resources/Gun.wav"));
+    fuelSound.setBuffer(resources.getSoundBuffer("resources/fuelsound.mp3"));
 
     backgroundSprite.setTexture(backgroundTexture);
     backgroundSprite.setScale(static_cast<float>(WINDOW_WIDTH * 3) / backgroundTexture.getSize().x,
@@ -102,22 +81,19 @@ Game::Game()
     minimapTexture.clear(sf::Color::Black);
     minimapTexture.create(MINIMAP_WIDTH, MINIMAP_HEIGHT);
 
-    if (!minimapBackgroundTexture.loadFromFile("resources/space4.jpg"))
-    {
-        std::cerr << "Failed to load pixelminimap.png" << std::endl;
-    }
-    minimapBackgroundSprite.setTexture(minimapBackgroundTexture);
-    minimapBackgroundSprite.setScale(static_cast<float>(MINIMAP_WIDTH) / minimapBackgroundTexture.getSize().x,
-                                     static_cast<float>(MINIMAP_HEIGHT) / minimapBackgroundTexture.getSize().y);
+    // the minimap shows the same picture as the background, so it shares its texture
+    minimapBackgroundSprite.setTexture(backgroundTexture);
+    minimapBackgroundSprite.setScale(static_cast<float>(MINIMAP_WIDTH) / backgroundTexture.getSize().x,
+                                     static_cast<float>(MINIMAP_HEIGHT) / backgroundTexture.getSize().y);
 }
 
 void Game::updateScoreboard()
 {
     // this updates the text for score, lives, and shields
-    scoreText.setString("Score: " + std::to_string(score));
-    livesText.setString("Lives: " + (numLives > 0 ? std::to_string(numLives) : "DEAD"));
-    shieldsText.setString("Shields: " + std::to_string(numShields));
-    humanoidText.setString("Humanoids Alive: " + std::to_string(numHumanoids));
+    scoreText.setString("Score: " + std::to_string(simulation.getScore()));
+    livesText.setString("Lives: " + (simulation.getNumLives() > 0 ? std::to_string(simulation.getNumLives()) : "DEAD"));
+    shieldsText.setString("Shields: " + std::to_string(simulation.getNumShields()));
+    humanoidText.setString("Humanoids Alive: " + std::to_string(simulation.getNumHumanoids()));
     fuelText.setString("Fuel Remaining");
 }
 
@@ -126,365 +102,359 @@ void Game::run()
     while (window.isOpen())
     {
         sf::Time frameTime = frameClock.restart();
-        float deltaTime = frameTime.asSeconds();
+        float deltaTime = std::min(frameTime.asSeconds(), MAX_FRAME_TIME);
 
-        player.handleInput(window, lasers);
-        minimapTexture.clear(sf::Color::Black);
-        // this calculates the maximum allowable background position
-        float maxBackgroundX = WINDOW_WIDTH - backgroundSprite.getGlobalBounds().width;
-        // Update and draw humanoids
+        processEvents();
+        InputState input = readInput();
 
-        // this limits the background scrolling to the left
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) && backgroundPosition.x < 0)
+        // the simulation only ever advances in fixed steps, however long the frame took
+        accumulator += deltaTime;
+        while (accumulator >= SIM_TIME_STEP)
         {
-            backgroundPosition.x += BACKGROUND_SCROLL_SPEED * deltaTime;
+            if (isRecording)
+            {
+                recording.record(input);
+            }
+            simulation.update(SIM_TIME_STEP, input);
+            playSounds(simulation.getEvents());
+            accumulator -= SIM_TIME_STEP;
         }
+        float alpha = accumulator / SIM_TIME_STEP;
 
-        // this limits the background scrolling to the right
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) && backgroundPosition.x > -WINDOW_WIDTH - 100)
+        if (simulation.player.isGamePlaying() && input.fire)
         {
-            backgroundPosition.x -= BACKGROUND_SCROLL_SPEED * deltaTime;
+            isGameActive = true;
+            splashScreenDisplayed = false;
         }
 
-        backgroundSprite.setPosition(backgroundPosition);
-        window.clear();
-        window.draw(backgroundSprite);
+        render(deltaTime, input, alpha);
 
-        if (isGameActive)
+        if (simulation.isGameOver())
         {
-
-            // this checks if it's time to update the player dot on the minimap
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) && backgroundPosition.x < 0)
-            {
-                backgroundPosition.x += BACKGROUND_SCROLL_SPEED * deltaTime;
-            }
-
-            // this limits the background scrolling to the right
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) && backgroundPosition.x > -WINDOW_WIDTH - 100)
+            gameOver = true;
+            gameWon = simulation.isGameWon();
+            allHumanoidsDead = simulation.areAllHumanoidsDead();
+            saveRecording();
+            if (simulation.isOutOfFuel())
             {
-                backgroundPosition.x -= BACKGROUND_SCROLL_SPEED * deltaTime;
+                crashPlayer();
             }
-            sf::Vector2f scaleFactor(
-                static_cast<float>(backgroundTexture.getSize().x) / static_cast<float>(MINIMAP_WIDTH / 20),
-                static_cast<float>(backgroundTexture.getSize().y) / static_cast<float>(MINIMAP_HEIGHT / 10));
-
-            // this updates the scrolling background and minimap background position
-            backgroundSprite.setPosition(backgroundPosition);
-            minimapBackgroundSprite.setPosition(backgroundPosition.x / scaleFactor.x, backgroundPosition.y / scaleFactor.y);
-
-            sf::RectangleShape minimapBorder(sf::Vector2f(MINIMAP_WIDTH * 3 + BORDER_SIZE * 2, MINIMAP_HEIGHT * 2 + BORDER_SIZE * 2));
-            minimapBorder.setFillColor(sf::Color::Transparent);
-            minimapBorder.setOutlineThickness(BORDER_SIZE);  // this sets the border thickness
-            minimapBorder.setOutlineColor(sf::Color::White); // this Sets the border color
-
-            float maxBackgroundX = WINDOW_WIDTH - backgroundSprite.getGlobalBounds().width;
-
-            // this calculates the player dot's position on the minimap
-            float playerDotX = player.getPlayerPosition().x * (MINIMAP_WIDTH / static_cast<float>(WINDOW_WIDTH));
-            float playerDotY = player.getPlayerPosition().y * (MINIMAP_HEIGHT / static_cast<float>(WINDOW_HEIGHT));
-
-            sf::CircleShape playerDot(2.0f); // this creates a small dot for the player on the mini map
-            playerDot.setFillColor(sf::Color::Blue);
-            playerDot.setPosition(playerDotX, playerDotY);
-            spawnHumanoids();
-
-            // this draws the minimap at the top of the screen
-            sf::Sprite minimapSprite(minimapTexture.getTexture());
-            minimapTexture.draw(minimapBackgroundSprite);
-            minimapSprite.setPosition(static_cast<float>(WINDOW_WIDTH) - MINIMAP_WIDTH - 1000.0f, 10.0f);
-            minimapSprite.setScale(3.0f, 2.0f);
-            minimapBorder.setPosition(minimapSprite.getPosition().x - BORDER_SIZE, minimapSprite.getPosition().y - BORDER_SIZE);
-            window.draw(minimapBorder);
-            // this draws the player dot on the minimap
-            minimapTexture.draw(playerDot);
-
-            // Update and draw humanoids
-
-            for (const auto &lander : landers)
-            {
-                if (!lander.isDestroyed())
-                {
+            showGameOverScreen();
+        }
 
-                    float landerDotX = lander.getPosition().x * (MINIMAP_WIDTH / static_cast<float>(WINDOW_WIDTH));
-                    float landerDotY = lander.getPosition().y * (MINIMAP_HEIGHT / static_cast<float>(WINDOW_HEIGHT));
+#ifdef FRAME_PROFILER
+        drawProfilerOverlay();
+#endif
+        {
+            PROFILE_PHASE(&profiler, PHASE_DISPLAY);
+            window.display();
+        }
+#ifdef FRAME_PROFILER
+        profiler.endFrame();
+#endif
+    }
+    saveRecording();
 
-                    sf::CircleShape landerDot(2.0f); // this creates a small dot for the Lander
-                    landerDot.setFillColor(sf::Color::Yellow);
-                    landerDot.setPosition(landerDotX, landerDotY);
-                    // this draws the Lander dot on the minimap
-                    minimapTexture.draw(landerDot);
-                }
-            }
+#ifdef FRAME_PROFILER
+    if (!profiler.saveToCsv(FRAME_TIMINGS_FILE))
+    {
+        std::cerr << "Failed to save " << FRAME_TIMINGS_FILE << std::endl;
+    }
+#endif
+}
 
-            for (const auto &humanoid : humanoids)
-            {
-                if (!humanoid.isDestroyed())
-                {
-                    // Calculate the position of the humanoid dot on the minimap
-                    float humanoidDotX = humanoid.getPosition().x * (MINIMAP_WIDTH / static_cast<float>(WINDOW_WIDTH));
-                    float humanoidDotY = humanoid.getPosition().y * (MINIMAP_HEIGHT / static_cast<float>(WINDOW_HEIGHT));
+#ifdef FRAME_PROFILER
+void Game::drawProfilerOverlay()
+{
+    PROFILE_PHASE(&profiler, PHASE_HUD);
+    if (!showProfilerOverlay)
+    {
+        return;
+    }
 
-                    sf::CircleShape humanoidDot(2.0f);
-                    humanoidDot.setFillColor(sf::Color::Green); // You can choose the color you like
-                    humanoidDot.setPosition(humanoidDotX, humanoidDotY);
+    // average and worst time of each phase over the frames in the profiler's history
+    std::ostringstream overlay;
+    overlay << std::fixed << std::setprecision(2) << "phase        avg ms   max ms\n";
+    float totalAverage = 0.0f;
+    for (int i = 0; i < NUM_FRAME_PHASES; i++)
+    {
+        FramePhase phase = static_cast<FramePhase>(i);
+        totalAverage += profiler.getAverage(phase);
+        overlay << std::left << std::setw(12) << FrameProfiler::getPhaseName(phase) << std::right
+                << std::setw(7) << profiler.getAverage(phase) << std::setw(9) << profiler.getMax(phase) << "\n";
+    }
+    overlay << std::left << std::setw(12) << "total" << std::right << std::setw(7) << totalAverage;
 
-                    // Draw the humanoid dot on the minimap
-                    minimapTexture.draw(humanoidDot);
-                }
-            }
+    profilerText.setString(overlay.str());
+    window.draw(profilerText);
+}
+#endif
 
-            // Inside your game loop
-            // Inside your game loop
+void Game::saveRecording()
+{
+    if (!isRecording)
+    {
+        return;
+    }
+    isRecording = false;
+    if (!recording.saveToFile(recordingFile))
+    {
+        std::cerr << "Failed to save recording to " << recordingFile << std::endl;
+    }
+}
 
-            window.draw(minimapBackgroundSprite);
-            window.draw(minimapSprite);
+void Game::processEvents()
+{
+    PROFILE_PHASE(&profiler, PHASE_EVENTS);
+    sf::Event event;
 
-            minimapTexture.display();
+    while (window.pollEvent(event))
+    {
+        if (event.type == sf::Event::Closed)
+        {
+            window.close();
         }
-
-        updateScoreboard();
-
-        window.draw(scoreText);
-        window.draw(fuelText);
-        window.draw(livesText);
-        window.draw(shieldsText);
-        window.draw(humanoidText);
-        // this updates and draw Landers
-        for (auto &lander : landers)
+        else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
         {
-            lander.update(deltaTime, player.getPlayerPosition(), humanoidPositions);
-
-            if (lander.isDestroyed())
-            {
-                lander.draw(window);
-            }
+            window.close();
         }
-
-        if (numLandersDestroyed > 10 && numLives!=0)
+#ifdef FRAME_PROFILER
+        else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3)
         {
-            gameWon = true;
-            showGameOverScreen();
+            showProfilerOverlay = !showProfilerOverlay;
         }
+#endif
+    }
+}
 
-        if (player.isGamePlaying())
-        {
-            player.update(lasers);
+InputState Game::readInput() const
+{
+    InputState input;
+    input.up = sf::Keyboard::isKeyPressed(sf::Keyboard::Up);
+    input.down = sf::Keyboard::isKeyPressed(sf::Keyboard::Down);
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+    input.fire = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    input.shield = sf::Keyboard::isKeyPressed(sf::Keyboard::Q);
+    return input;
+}
 
-            spawnHumanoids();
+void Game::playSounds(const SimEvents &events)
+{
+    if (events.laserFired)
+    {
+        laserSound.play();
+    }
+    if (events.humanoidKilled)
+    {
+        HumanoidSound.play();
+    }
+    if (events.landerDestroyed)
+    {
+        explosionSound.play();
+    }
+    if (events.shieldRaised)
+    {
+        shieldSound.play();
+    }
+    if (events.playerHit)
+    {
+        crashSound.play();
+    }
+    if (events.fuelCollected)
+    {
+        fuelSound.play();
+    }
+}
 
-            updateHumanoids();
+void Game::render(float deltaTime, const InputState &input, float alpha)
+{
+    Player &player = simulation.player;
 
-            // Find the part where you create a new Lander object
-            if (spawnTimer.getElapsedTime().asSeconds() >= LANDER_SPAWN_COOLDOWN) // landers.size() < 5 &&
-            {
-                spawnLander();
-                spawnTimer.restart();
-            }
+    drawBackground(deltaTime, input);
+    drawMinimap(deltaTime, input);
+    drawHud();
 
-            for (auto &laser : lasers)
-            {
-                // change this code in a bit
-                for (Humanoid &humanoid : humanoids)
-                {
-                    // Check if the laser intersects with the humanoid's bounds
-                    if (laser.shape.getGlobalBounds().intersects(humanoid.getBounds()) && !humanoid.isCaptured() && !laser.isDestroyed() && !humanoid.isDestroyed() && (humanoid.isFalling() || humanoid.getPosition().y == WINDOW_HEIGHT - 100))
-                    {
-                        score -= 50;
-                        // Handle collision logic for humanoid here
-
-                        // Mark the humanoid for removal
-                        humanoid.setDestroy();
-                        HumanoidSound.play();
-                        numHumanoids--;
-                        laser.setDestroyed();
-                    }
-                }
-            }
+    if (!player.isGamePlaying())
+    {
+        drawSplashScreen();
+        splashScreenDisplayed = true;
+        return;
+    }
 
-            for (auto &laser : lasers)
-            {
-                if (!laser.isDestroyed())
-                {
-                    window.draw(laser.shape);
-                }
+    drawWorld(alpha);
+}
 
-                for (auto &lander : landers)
-                {
-                    if (lander.checkCollision(laser))
-                    {
-                        explosionSound.play();
-                        score += 50;
-                        lander.setDestroyed(); // true);
-                        numLandersDestroyed++;
-                        laser.setDestroyed();
-                    }
-                }
-            }
+void Game::drawBackground(float deltaTime, const InputState &input)
+{
+    PROFILE_PHASE(&profiler, PHASE_BACKGROUND);
+    minimapTexture.clear(sf::Color::Black);
 
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Q) && shieldCooldown.getElapsedTime().asSeconds() >= SHIELD_EFFECT_LENGTH)
-            {
-                if (numShields > 0)
-                {
-                    shieldCooldown.restart();
-                    shieldOn = true;
-                    shieldSound.play();
-                    numShields--;
-                }
-            }
-            if (shieldOn)
-            {
+    // this limits the background scrolling to the left
+    if (input.left && backgroundPosition.x < 0)
+    {
+        backgroundPosition.x += BACKGROUND_SCROLL_SPEED * deltaTime;
+    }
 
-                sf::Vector2f playerPosition = player.getPlayerPosition();
-                shieldFrame.setPosition(playerPosition);
-                // this sets the shield frame size to match the player's ship size
-                shieldFrame.setSize(sf::Vector2f(player.getPlayerBounds().width + 10, player.getPlayerBounds().height + 10));
-                // this flips the shield frame when the player changes directions
-                if (!player.isFacingRight)
-                {
-                    shieldFrame.setScale(-1.0f, 1.0f);
-                }
-                else
-                {
-                    shieldFrame.setScale(1.0f, 1.0f);
-                }
-                window.draw(shieldFrame);
-            }
-            // this checks if the shield is still active and apply its effects
-            if (shieldOn && shieldCooldown.getElapsedTime().asSeconds() >= 5.0f)
-            {
+    // this limits the background scrolling to the right
+    if (input.right && backgroundPosition.x > -WINDOW_WIDTH - 100)
+    {
+        backgroundPosition.x -= BACKGROUND_SCROLL_SPEED * deltaTime;
+    }
 
-                shieldOn = false;
-            }
+    backgroundSprite.setPosition(backgroundPosition);
+    window.clear();
+    window.draw(backgroundSprite);
+}
 
-            if (missileSpawnTimer.getElapsedTime().asSeconds() > 5.0f)
-            {
-                spawnMissilesFromLanders();
-                missileSpawnTimer.restart();
-            }
+void Game::drawMinimap(float deltaTime, const InputState &input)
+{
+    PROFILE_PHASE(&profiler, PHASE_MINIMAP);
+    Player &player = simulation.player;
 
-            player.spwanFuel(window);
-            player.fuelCanCollision();
+    if (isGameActive)
+    {
 
-            checkPlayerHumanoidCollision();
+        // this checks if it's time to update the player dot on the minimap
+        if (input.left && backgroundPosition.x < 0)
+        {
+            backgroundPosition.x += BACKGROUND_SCROLL_SPEED * deltaTime;
+        }
 
-            if (player.getFuel() <= 0)
-            {
+        // this limits the background scrolling to the right
+        if (input.right && backgroundPosition.x > -WINDOW_WIDTH - 100)
+        {
+            backgroundPosition.x -= BACKGROUND_SCROLL_SPEED * deltaTime;
+        }
+        sf::Vector2f scaleFactor(
+            static_cast<float>(backgroundTexture.getSize().x) / static_cast<float>(MINIMAP_WIDTH / 20),
+            static_cast<float>(backgroundTexture.getSize().y) / static_cast<float>(MINIMAP_HEIGHT / 10));
 
-                // Player has run out of fuel, trigger game over
-                while (player.getPlayerPosition().y <= WINDOW_HEIGHT - 20)
-                {
-                    player.PlayerSprite.move(0, PLAYER_SPEED);
-                    window.clear();
-                    window.draw(backgroundSprite);
-                    player.draw(window);
-                    window.display();
-                }
-                showGameOverScreen();
+        // this updates the scrolling background and minimap background position
+        backgroundSprite.setPosition(backgroundPosition);
+        minimapBackgroundSprite.setPosition(backgroundPosition.x / scaleFactor.x, backgroundPosition.y / scaleFactor.y);
+
+        sf::RectangleShape minimapBorder(sf::Vector2f(MINIMAP_WIDTH * 3 + BORDER_SIZE * 2, MINIMAP_HEIGHT * 2 + BORDER_SIZE * 2));
+        minimapBorder.setFillColor(sf::Color::Transparent);
+        minimapBorder.setOutlineThickness(BORDER_SIZE);  // this sets the border thickness
+        minimapBorder.setOutlineColor(sf::Color::White); // this Sets the border color
+
+        // this calculates the player dot's position on the minimap
+        float playerDotX = player.getPlayerPosition().x * (MINIMAP_WIDTH / static_cast<float>(WINDOW_WIDTH));
+        float playerDotY = player.getPlayerPosition().y * (MINIMAP_HEIGHT / static_cast<float>(WINDOW_HEIGHT));
+
+        sf::CircleShape playerDot(2.0f); // this creates a small dot for the player on the mini map
+        playerDot.setFillColor(sf::Color::Blue);
+        playerDot.setPosition(playerDotX, playerDotY);
+
+        // this draws the minimap at the top of the screen
+        sf::Sprite minimapSprite(minimapTexture.getTexture());
+        minimapTexture.draw(minimapBackgroundSprite);
+        minimapSprite.setPosition(static_cast<float>(WINDOW_WIDTH) - MINIMAP_WIDTH - 1000.0f, 10.0f);
+        minimapSprite.setScale(3.0f, 2.0f);
+        minimapBorder.setPosition(minimapSprite.getPosition().x - BORDER_SIZE, minimapSprite.getPosition().y - BORDER_SIZE);
+        window.draw(minimapBorder);
+        // this draws the player dot on the minimap
+        minimapTexture.draw(playerDot);
+
+        const Registry &registry = simulation.registry;
+        for (std::size_t i = 0; i < registry.landers.size(); i++)
+        {
+            if (!registry.landers[i].destroyed)
+            {
+                sf::Vector2f landerPosition = registry.transforms.get(registry.landers.getEntity(i)).position;
+                float landerDotX = landerPosition.x * (MINIMAP_WIDTH / static_cast<float>(WINDOW_WIDTH));
+                float landerDotY = landerPosition.y * (MINIMAP_HEIGHT / static_cast<float>(WINDOW_HEIGHT));
+
+                sf::CircleShape landerDot(2.0f); // this creates a small dot for the Lander
+                landerDot.setFillColor(sf::Color::Yellow);
+                landerDot.setPosition(landerDotX, landerDotY);
+                // this draws the Lander dot on the minimap
+                minimapTexture.draw(landerDot);
             }
+        }
 
-            for (auto &lander : landers)
+        for (std::size_t i = 0; i < registry.humanoids.size(); i++)
+        {
+            if (!registry.humanoids[i].destroyed)
             {
-                checkLanderHumanoidCollisions(lander);
-                if (!lander.isDestroyed())
-                {
-                    lander.update(deltaTime, player.getPlayerPosition(), humanoidPositions);
+                // Calculate the position of the humanoid dot on the minimap
+                sf::Vector2f humanoidPosition = registry.transforms.get(registry.humanoids.getEntity(i)).position;
+                float humanoidDotX = humanoidPosition.x * (MINIMAP_WIDTH / static_cast<float>(WINDOW_WIDTH));
+                float humanoidDotY = humanoidPosition.y * (MINIMAP_HEIGHT / static_cast<float>(WINDOW_HEIGHT));
 
-                    // this checks for collision between player and lander
-                    if (player.getPlayerBounds().intersects(lander.landerSprite.getGlobalBounds()) && !shieldOn && intersectionCollisionTimer.getElapsedTime().asSeconds() >= 2.0f)
-                    {
-                        crashSound.play();
-                        intersectionCollisionTimer.restart();
-
-                        numLives--;
-                        numLandersDestroyed++;
-                        if (numLives <= 0)
-                        {
-                            newGameTimer.restart();
-                            gameOver = true;
-                            gameWon = false;
-                        }
-
-                        if (gameOver)
-                        {
-                            showGameOverScreen();
-                        }
-                        else if (gameOver && sf::Keyboard::isKeyPressed(sf::Keyboard::N) && newGameTimer.getElapsedTime().asSeconds() >= 5.0f)
-                        {
-                            // this resets the game if the player presses 'N'
-
-                            showGameOverScreen();
-                            resetGame();
-                        }
-                        lander.setDestroyed();
-                    }
-                    else
-                    {
-                        if (!lander.isDestroyed())
-                        {
-                            lander.draw(window);
-                        }
-                    }
-                }
+                sf::CircleShape humanoidDot(2.0f);
+                humanoidDot.setFillColor(sf::Color::Green); // You can choose the color you like
+                humanoidDot.setPosition(humanoidDotX, humanoidDotY);
+
+                // Draw the humanoid dot on the minimap
+                minimapTexture.draw(humanoidDot);
             }
+        }
 
-            for (auto it = missiles.begin(); it != missiles.end();)
-            {
-                it->update(deltaTime);
+        window.draw(minimapBackgroundSprite);
+        window.draw(minimapSprite);
 
-                sf::FloatRect missileBounds = it->getBounds();
-                sf::FloatRect landerBounds = lander.getLanderBounds();
-                sf::FloatRect playerBounds = player.getPlayerBounds();
+        minimapTexture.display();
+    }
+}
 
-                if (missileBounds.intersects(playerBounds) && !shieldOn && collisionTimer.getElapsedTime().asSeconds() >= 1.5f)
-                {
-                    crashSound.play();
-                    collisionTimer.restart();
-                    numLives--;
-                    if (numLives <= 0)
-                    {
-                        newGameTimer.restart();
-                        gameOver = true;
-                    }
-                    if (gameOver)
-                    {
-                        showGameOverScreen();
-                    }
-                    else if (gameOver && sf::Keyboard::isKeyPressed(sf::Keyboard::N) && newGameTimer.getElapsedTime().asSeconds() >= 5.0f)
-                    {
-                        // this resets the game if the player presses space
-                        showGameOverScreen();
+void Game::drawHud()
+{
+    PROFILE_PHASE(&profiler, PHASE_HUD);
+    updateScoreboard();
+
+    window.draw(scoreText);
+    window.draw(fuelText);
+    window.draw(livesText);
+    window.draw(shieldsText);
+    window.draw(humanoidText);
+}
 
-                        resetGame();
-                    }
-                    it = missiles.erase(it);
-                }
-                else if (missileBounds.top + missileBounds.height < 0)
-                {
-                    it = missiles.erase(it);
-                }
-                else
-                {
-                    it->draw(window);
-                    ++it;
-                }
-            }
+void Game::drawWorld(float alpha)
+{
+    PROFILE_PHASE(&profiler, PHASE_DRAW);
+    Player &player = simulation.player;
 
-            player.draw(window);
-            drawHumanoids();
+    simulation.projectiles.draw(window, alpha);
 
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space))
-            {
-                isGameActive = true;
-                player.startGame();
-                splashScreenDisplayed = false;
-            }
-            lander.update(deltaTime, player.getPlayerPosition(), humanoidPositions);
+    if (simulation.isShieldOn())
+    {
+        sf::Vector2f playerPosition = player.getInterpolatedPosition(alpha);
+        shieldFrame.setPosition(playerPosition);
+        // this sets the shield frame size to match the player's ship size
+        shieldFrame.setSize(sf::Vector2f(player.getPlayerBounds().width + 10, player.getPlayerBounds().height + 10));
+        // this flips the shield frame when the player changes directions
+        if (!player.isFacingRight)
+        {
+            shieldFrame.setScale(-1.0f, 1.0f);
         }
         else
         {
-            drawSplashScreen();
-            splashScreenDisplayed = true;
+            shieldFrame.setScale(1.0f, 1.0f);
         }
+        window.draw(shieldFrame);
+    }
+
+    player.spwanFuel(window);
+
+    drawSprites(simulation.registry, window, alpha); // the landers and humanoids
+
+    player.draw(window, alpha);
+}
+
+void Game::crashPlayer()
+{
+    Player &player = simulation.player;
+
+    frameClock.restart();
+    while (player.getPlayerPosition().y <= WINDOW_HEIGHT - 20)
+    {
+        player.PlayerSprite.move(0, PLAYER_SPEED * frameClock.restart().asSeconds());
+        player.savePreviousPosition();
+        window.clear();
+        window.draw(backgroundSprite);
+        player.draw(window);
         window.display();
     }
 }
@@ -493,14 +463,12 @@ void Game::drawSplashScreen()
 {
     window.clear();
 
-    sf::Texture backgroundTexture;
-    if (!backgroundTexture.loadFromFile("resources/8bitspace.jpg"))
+    // this is drawn every frame until the game starts, so its resources come from the cache
+    sf::Sprite backgroundImage;
+    if (!getResourceCache().loadSprite(backgroundImage, "resources/8bitspace.jpg"))
     {
-        std::cerr << "Failed to load background image" << std::endl;
         return;
     }
-    sf::Sprite backgroundImage;
-    backgroundImage.setTexture(backgroundTexture);
     backgroundImage.setScale(3, 2.5);
 
     // Set the window to use the view of the splash screen (optional)
@@ -508,13 +476,6 @@ void Game::drawSplashScreen()
 
     // Draw the background image
     window.draw(backgroundImage);
-    sf::Font font;
-    if (!font.loadFromFile("resources/INVASION2000.ttf"))
-    {
-        std::cerr << "Failed to load font file" << std::endl;
-        return;
-    }
-
     sf::Text text("SPACE DEFENDER\n\nPress SPACE to play\nPress ESC to exit \n \n HOW TO PLAY: \n PRESS ARROW KEYS TO MOVE \n PRESS SPACEBAR TO SHOOT \n PRESS Q FOR SHIELD", font, 60);
     text.setFillColor(sf::Color::White);
     text.setStyle(sf::Text::Bold);
@@ -535,48 +496,13 @@ sf::Vector2u Game::getWindowSize() const
 
 void Game::spawnLander()
 {
-    if (spawnTimer.getElapsedTime().asSeconds() >= LANDER_SPAWN_COOLDOWN && totalLandersSpawned <= 10)
-    {
-        // this creates a new Lander dynamically and add it to the vector using smart pointers
-        Lander *newLander = new Lander(LANDER_SPAWN_COOLDOWN);
-        landers.emplace_back(*newLander);
-        activeLander = newLander; // this sets the active lander pointer to the new lander
-        spawnTimer.restart();
-
-        // Increment the total number of landers spawned
-        totalLandersSpawned++;
-    }
-}
-
-void Game::spawnMissilesFromLanders()
-{
-    for (auto &lander : landers)
-    {
-        if (!lander.isDestroyed())
-        {
-            sf::Vector2f landerPosition = lander.landerSprite.getPosition();
-            sf::Vector2f playerPosition = player.getPlayerPosition();
-            // this creates a new missile with the player's position as the target
-            missiles.emplace_back(Missile(landerPosition.x, landerPosition.y, playerPosition));
-        }
-    }
+    simulation.spawnLander();
 }
 
 void Game::showGameOverScreen()
 {
     isGameOverScreenDisplayed = true;
-    sf::Font font;
-    if (!font.loadFromFile("resources/INVASION2000.ttf"))
-    {
-        std::cerr << "Failed to load font file" << std::endl;
-        return;
-    }
-    sf::Font font2;
-    if (!font2.loadFromFile("resources/sansation.ttf"))
-    {
-        std::cerr << "Failed to load font2 file" << std::endl;
-        return;
-    }
+    const sf::Font &font2 = getResourceCache().getFont("resources/sansation.ttf");
 
     sf::Text winText("You Win!", font, 60);
     winText.setFillColor(sf::Color::Green);
@@ -593,7 +519,7 @@ void Game::showGameOverScreen()
     gameOverText.setStyle(sf::Text::Bold);
     gameOverText.setPosition(WINDOW_WIDTH / 2 - 300, WINDOW_HEIGHT / 2);
 
-    sf::Text scoreText("Score: " + std::to_string(score), font, 40);
+    sf::Text scoreText("Score: " + std::to_string(simulation.getScore()), font, 40);
     scoreText.setFillColor(sf::Color::White);
     scoreText.setPosition(WINDOW_WIDTH / 2 - 300, WINDOW_HEIGHT / 2 + 50.0f);
 
@@ -666,7 +592,7 @@ void Game::showGameOverScreen()
                     typingName = false;
 
                     // Add the player's score to the high scores
-                    highScoreManager.addHighScore(playerName, score);
+                    highScoreManager.addHighScore(playerName, simulation.getScore());
                 }
                 else if (nameEntered && event.key.code != sf::Keyboard::Return)
                 {
@@ -715,126 +641,17 @@ void Game::showGameOverScreen()
 void Game::resetGame()
 {
     // this resets game-related variables to their initial values
-    score = 0;
-    numLives = INITIAL_NUM_LIVES;
-    numShields = 3;
-    numHumanoids = 5;
-    allHumanoidsDead = 0;
-
-    numHumanoidsInTotal = 0;
-    totalLandersSpawned = 0;
-    numLandersDestroyed = 0;
-    player.PlayerSprite.setPosition(WINDOW_WIDTH / 2 - player.PlayerSprite.getLocalBounds().width / 2,
-                                    WINDOW_HEIGHT / 2 - player.PlayerSprite.getLocalBounds().height / 2);
-    player.setFuel(100);
+    simulation.reset();
+    allHumanoidsDead = false;
     isGameOverScreenDisplayed = false;
-
-    missiles.clear();
     gameOver = false;
-    // this clears the landers and lasers vectors
-    humanoids.clear();
-    landers.clear();
-    lasers.clear();
-    shieldOn = false;
-    player.PlayerSprite.setPosition(WINDOW_WIDTH / 2, WINDOW_HEIGHT / 2);
+    gameWon = false;
     run();
 }
 
-void Game::spawnHumanoids()
-{
-    if (humanoids.size() < 5 && numHumanoidsInTotal <= 4) // Limit the total number of humanoids
-    {
-        // Generate a random position at the bottom of the screen
-        float x = static_cast<float>(rand() % WINDOW_WIDTH);
-        float y = static_cast<float>(WINDOW_HEIGHT - 100);
-
-        // Create a new humanoid and set its position
-        Humanoid newHumanoid(x, y, humanoidTexture);
-        // sf::Vector2f humanoidPosition = sf::Vector2f(x, y);
-        // humanoidPositions.push_back(humanoidPosition);
-        humanoidPositions.emplace_back(x, y);
-        // Add the humanoid to the vector of humanoids
-        humanoids.push_back(newHumanoid);
-        numHumanoidsInTotal++;
-    }
-}
-
-void Game::updateHumanoids()
-{
-    // Iterate through your humanoid objects and update their positions
-    int i = 0;
-    for (Humanoid &humanoid : humanoids)
-    {
-        // Assuming your Humanoid class has a function to update its position, e.g., updatePosition()
-        humanoid.update(numHumanoids); // You should implement this function in your Humanoid class
-        humanoidPositions[i] = humanoid.getPosition();
-        if (numHumanoids <= 0)
-        {
-            allHumanoidsDead = true;
-            gameOver = true;
-            gameWon = false;
-            showGameOverScreen();
-        }
-        i++;
-    }
-}
-
-void Game::drawHumanoids()
-{
-    for (Humanoid &humanoid : humanoids)
-    {
-        if (!humanoid.isDestroyed())
-        {
-            humanoid.draw(window);
-        }
-    }
-}
-
-void Game::checkLanderHumanoidCollisions(Lander &lander)
-{
-    for (Humanoid &humanoid : humanoids)
-    {
-        if (humanoid.getBounds().intersects(lander.landerSprite.getGlobalBounds())) //&& !lander.humanoidIsCaptured())
-        {
-            humanoid.capture(lander.getPosition());
-            lander.hasCapturedHumanoid();
-        }
-        else if (lander.humanoidIsCaptured() && humanoid.isCaptured() && !lander.isDestroyed())
-        {
-            humanoid.capture(lander.getPosition());
-        }
-        
-        else if (lander.isDestroyed() && humanoid.isCaptured())
-        {
-            humanoid.release();
-        }
-    }
-}
-
-void Game::checkPlayerHumanoidCollision()
-{
-    for (Humanoid &humanoid : humanoids)
-    {
-        if (player.getPlayerBounds().intersects(humanoid.getBounds()) && humanoid.isFalling() && humanoid.getPosition().y != WINDOW_HEIGHT - 50) //&& !player.isHumanoidCaptured())
-        {
-            humanoid.capture(player.getPlayerPosition());
-            player.setHumanoidCaptured(true);
-            humanoid.setPlayerCaptured(true);
-            humanoid.update(numHumanoids);
-        }
-        else if (player.getPlayerPosition().y >= WINDOW_HEIGHT - 200 && player.isHumanoidCaptured() && humanoid.isPlayerCaptured())
-        {
-            humanoid.deposit(player.getPlayerPosition().x);
-            player.setHumanoidCaptured(false);
-            humanoid.setPlayerCaptured(false);
-            humanoid.update(numHumanoids);
-        }
-    }
-}
-
 int Game::getNumLandersDestroyed()
 {
-    return numLandersDestroyed;
+    return simulation.getNumLandersDestroyed();
 }
 
 void Game::setGameWon()
@@ -3,31 +3,31 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <vector>
-#include "Player.h"
-#include "Laser.h"
-#include "Lander.h"
-#include "Humanoid.h"
+#include "Simulation.h"
 #include "HighScore.h"
-// initialise constant global variables
-const int WINDOW_WIDTH = 1600;
-const int WINDOW_HEIGHT = 900;
-const float PLAYER_SPEED = 5.0f;
-const float LASER_SPEED = 10.0f;
-const float LASER_COOLDOWN = 0.5f;
+#include "InputRecording.h"
+#include "FrameProfiler.h"
 
 /**
  * @class Game
  * @brief The Game class represents the main game engine.
  *
- * This class is responsible for managing the game, including player interactions, scoring, and game state.
+ * This class is responsible for the window, input, sound and drawing. The game world itself lives in
+ * a Simulation that the Game steps at a fixed rate, as many times per frame as the frame time needs,
+ * and frames are drawn between the last two steps.
  */
 class Game
 {
 public:
     /**
      * @brief Construct a new Game object.
+     *
+     * @param recordingFile Where to save the controls of the first game, for replaying it later.
+     * An empty name turns recording off.
      */
-    Game();
+    explicit Game(const std::string &recordingFile = "last_session.rec");
+
+    Simulation simulation; /**< The game world that is drawn in the window. */
 
     /**
      * @brief Run the game loop.
@@ -39,11 +39,8 @@ public:
      */
     void drawSplashScreen();
     sf::RenderTexture minimapTexture;
-    sf::Clock intersectionCollisionTimer;
     sf::Clock frameClock; // intialise clock for timer synchronisation
-    sf::Clock humanoidSpawnClock;
-    sf::Clock shieldCooldown;
-    sf::Clock missileSpawnTimer;
+    float accumulator;    // frame time not yet consumed by fixed simulation steps
     sf::RenderWindow window;
 
     /**
@@ -69,13 +66,6 @@ public:
      * @brief Update the scoreboard.
      */
     void updateScoreboard();
-
-    /**
-     * @brief Spawn missiles from active landers.
-     */
-    void spawnMissilesFromLanders();
-    Lander *activeLander;
-    sf::Texture humanoidTexture;
     sf::Sprite backgroundSprite;
     sf::Vector2f backgroundPosition;
 
@@ -88,8 +78,6 @@ public:
     bool isGameOverScreenDisplayed;
     bool allHumanoidsDead;
     bool typingName; // this is needed to stop name character inputs from being interpreted as commands
-    sf::Clock playerDotUpdateTimer;
-    Player player;
 
     /**
      * @brief Show the game over screen.
@@ -100,108 +88,139 @@ public:
      * @brief Reset the game to its initial state.
      */
     void resetGame();
-    sf::Texture minimapBackgroundTexture;
     sf::Sprite minimapBackgroundSprite;
 
     /**
-     * @brief Spawn humanoids at the bottom of the screen.
+     * @brief Get the number of landers destroyed.
+     *
+     * @return The number of landers destroyed.
      */
-    void spawnHumanoids();  // Spawns humanoids at the bottom of the screen.
-    
+    int getNumLandersDestroyed();
+
     /**
-     * @brief Update humanoid movement and interactions.
+     * @brief Set the game as won.
      */
-    void updateHumanoids(); // Update humanoid movement and interactions.
-    
+    void setGameWon();
+
     /**
-     * @brief Draw humanoids on the game window.
+     * @brief Check if the game is won.
+     *
+     * @return True if the game is won, false otherwise.
      */
-    void drawHumanoids();
+    bool getGamewon();
 
     /**
-     * @brief Check collisions between landers and humanoids.
+     * @brief Check if the game over screen is displayed.
+     *
+     * @return True if the game over screen is displayed, false otherwise.
      */
-    void checkLanderHumanoidCollisions(Lander &lander); // std::vector<Lander>::iterator it);
+    bool getIsGameOverScreenDisplayed();
+
 
+private:
     /**
-     * @brief Check collisions between the player and humanoids.
+     * @brief Handle window events such as closing the window.
      */
-    void checkPlayerHumanoidCollision();
+    void processEvents();
 
     /**
-     * @brief Get the number of landers destroyed.
+     * @brief Read the player's controls from the keyboard.
      *
-     * @return The number of landers destroyed.
+     * @return The controls held down this frame.
      */
-    int getNumLandersDestroyed();
+    InputState readInput() const;
 
     /**
-     * @brief Set the game as won.
+     * @brief Play the sounds for what happened during the last simulation update.
+     *
+     * @param events The events of the last simulation update.
      */
-    void setGameWon();
+    void playSounds(const SimEvents &events);
 
     /**
-     * @brief Check if the game is won.
+     * @brief Draw the current frame.
      *
-     * @return True if the game is won, false otherwise.
+     * @param deltaTime The time passed since the last frame.
+     * @param input The controls held down this frame, used to scroll the background.
+     * @param alpha How far this frame is between the last two simulation updates, from 0 to 1.
      */
-    bool getGamewon();
+    void render(float deltaTime, const InputState &input, float alpha);
 
     /**
-     * @brief Check if the game over screen is displayed.
+     * @brief Scroll and draw the background.
      *
-     * @return True if the game over screen is displayed, false otherwise.
+     * @param deltaTime The time passed since the last frame.
+     * @param input The controls held down this frame.
      */
-    bool getIsGameOverScreenDisplayed();
+    void drawBackground(float deltaTime, const InputState &input);
 
+    /**
+     * @brief Render the minimap into its texture and draw it, once the game is active.
+     *
+     * @param deltaTime The time passed since the last frame.
+     * @param input The controls held down this frame.
+     */
+    void drawMinimap(float deltaTime, const InputState &input);
+
+    /**
+     * @brief Update and draw the score, lives, shields and humanoid counts.
+     */
+    void drawHud();
+
+    /**
+     * @brief Draw the lasers and missiles, shield, fuel can, landers, humanoids and player.
+     *
+     * @param alpha How far this frame is between the last two simulation updates, from 0 to 1.
+     */
+    void drawWorld(float alpha);
+
+    /**
+     * @brief Let the player's ship drop to the ground after it ran out of fuel.
+     */
+    void crashPlayer();
+
+    /**
+     * @brief Save the recorded controls and stop recording.
+     *
+     * Only the first game is recorded, because a replay always starts from a new Simulation.
+     */
+    void saveRecording();
+
+#ifdef FRAME_PROFILER
+    /**
+     * @brief Draw the per-phase frame times, if the overlay is switched on with F3.
+     */
+    void drawProfilerOverlay();
+
+    FrameProfiler profiler; // per-phase times of the last few seconds of frames
+    bool showProfilerOverlay;
+    sf::Text profilerText;
+#endif
+
+    InputRecording recording; // the controls of every simulation update so far
+    std::string recordingFile;
+    bool isRecording;
 
-private:
-    int score;
-    int numLives;
-    int numShields;
-    int numHumanoids;
     HighScore highScoreManager; // Create an instance of the HighScore class
-    sf::Font font;
+    const sf::Font &font; /**< Shared through the resource cache. */
     sf::Text scoreText;
     sf::Text livesText;
     sf::Text shieldsText;
     sf::Text humanoidText;
     sf::Text fuelText;
     sf::RectangleShape shieldFrame;
-    bool shieldOn;
-    std::vector<Laser> lasers;
-    sf::Texture backgroundTexture;
-    sf::SoundBuffer explosionBuffer;
+    const sf::Texture &backgroundTexture; /**< Shared through the resource cache, with the minimap background. */
     sf::Sound explosionSound;
-    sf::SoundBuffer intersectionBuffer;
     sf::Sound intersectionSound;
-    sf::SoundBuffer HumanoidBuffer;
     sf::Sound HumanoidSound;
-    sf::SoundBuffer missileBuffer;
     sf::Sound missileSound;
-    sf::SoundBuffer shieldBuffer;
     sf::Sound shieldSound;
-    sf::SoundBuffer crashBuffer;
     sf::Sound crashSound;
-    Lander lander;
+    sf::Sound laserSound;
+    sf::Sound fuelSound;
     bool splashScreenDisplayed; // for test purposes
-    std::vector<Missile> missiles;
-    std::vector<Lander> landers;
-
-    std::vector<Humanoid> humanoids;
-
-    /**
-     * @brief Create a new lander.
-     */
-    void createLander();
-    sf::Clock spawnTimer;
-    sf::Clock newGameTimer;
-    sf::Clock collisionTimer;
-    int totalLandersSpawned;
-    int numLandersDestroyed;
-    int numHumanoidsInTotal;
     bool gameWon; // this is a flag to indicate if the player has won the game
-    
+
     /**
      * @brief Check if the game is won.
      *
@@ -213,9 +232,6 @@ private:
      * @brief Show the win screen.
      */
     void showWinScreen();
-    
-
-    std::vector<sf::Vector2f> humanoidPositions;
 };
 
 #endif
\ No newline at end of file
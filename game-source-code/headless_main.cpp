@@ -0,0 +1,170 @@
+#include <SFML/System.hpp>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "Simulation.h"
+#include "InputRecording.h"
+
+// Runs the game simulation without a window, as fast as the CPU allows, and reports how many
+// updates per second it managed. By default the ship is flown by a simple script so lasers,
+// landers, humanoids and missiles all get exercised; with --replay it plays back the controls
+// recorded from a real game instead. Either way the run stops early if the game ends, and the
+// report covers the ticks up to then.
+//
+// Projectiles are swept along their path each update, so --tick-rate can lower the update rate to
+// trade accuracy of movement for CPU time without lasers or missiles flying through anything.
+// --threads sets how many threads run the lander AI; the game played is the same for any number.
+//
+// usage: game_headless [--ticks N] [--seed S] [--landers N] [--humanoids N] [--tick-rate HZ] [--threads N]
+//        game_headless --replay FILE
+
+const long SWEEP_TICKS = 240; // how long the ship flies in one direction
+
+InputState scriptedInput(long tick)
+{
+    InputState input;
+    bool sweepRight = (tick / SWEEP_TICKS) % 2 == 0;
+    input.right = sweepRight;
+    input.left = !sweepRight;
+    input.fire = true;
+    return input;
+}
+
+void printUsage()
+{
+    std::cerr << "usage: game_headless [--ticks N] [--seed S] [--landers N] [--humanoids N] [--tick-rate HZ] [--threads N]" << std::endl;
+    std::cerr << "       game_headless --replay FILE" << std::endl;
+}
+
+// this reads a whole option value as a number, so "12abc" or "" is rejected rather than half read
+template <typename T>
+bool parseNumber(const std::string &value, T &number)
+{
+    std::istringstream in(value);
+    in >> number;
+    return !in.fail() && in.eof();
+}
+
+void printReport(const Simulation &simulation, long ticks, float elapsed)
+{
+    std::cout << "ticks: " << ticks << (simulation.isGameOver() ? " (game over)" : "") << "  seed: " << simulation.getConfig().seed
+              << "  landers: " << simulation.registry.landers.size() << "  humanoids: " << simulation.registry.humanoids.size() << std::endl;
+    std::cout << "elapsed: " << elapsed << " s  ticks/sec: " << (elapsed > 0 ? ticks / elapsed : 0) << std::endl;
+    std::cout << "score: " << simulation.getScore() << "  lives: " << simulation.getNumLives()
+              << "  landers destroyed: " << simulation.getNumLandersDestroyed()
+              << "  lasers: " << simulation.projectiles.count(OWNER_PLAYER) << "  missiles: " << simulation.projectiles.count(OWNER_LANDER)
+              << "  dropped: " << simulation.projectiles.getNumDropped() << std::endl;
+}
+
+int replay(const std::string &filename)
+{
+    InputRecording recording;
+    if (!recording.loadFromFile(filename))
+    {
+        std::cerr << "Failed to load recording " << filename << std::endl;
+        return 1;
+    }
+
+    // a replay starts from a new simulation, exactly like the recorded game did
+    Simulation simulation(recording.getConfig());
+    long ticks = static_cast<long>(recording.getNumTicks());
+
+    sf::Clock clock;
+    long tick = 0;
+    while (tick < ticks && !simulation.isGameOver())
+    {
+        simulation.update(SIM_TIME_STEP, recording.getInput(tick++));
+    }
+    float elapsed = clock.getElapsedTime().asSeconds();
+
+    printReport(simulation, tick, elapsed);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    long ticks = 10000;
+    float timeStep = SIM_TIME_STEP;
+    SimConfig config;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if (i + 1 >= argc)
+        {
+            printUsage();
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (option == "--replay" && argc == 3)
+        {
+            return replay(value);
+        }
+
+        long number = 0;
+        double rate = 0.0;
+        bool valid = false;
+        if (option == "--ticks" && parseNumber(value, number) && number >= 0)
+        {
+            ticks = number;
+            valid = true;
+        }
+        else if (option == "--seed" && parseNumber(value, number) && number >= 0)
+        {
+            config.seed = static_cast<unsigned int>(number);
+            valid = true;
+        }
+        else if (option == "--landers" && parseNumber(value, number) && number >= 0)
+        {
+            config.maxLanders = static_cast<int>(number);
+            valid = true;
+        }
+        else if (option == "--humanoids" && parseNumber(value, number) && number >= 0)
+        {
+            config.maxHumanoids = static_cast<int>(number);
+            valid = true;
+        }
+        else if (option == "--threads" && parseNumber(value, number) && number >= 0)
+        {
+            config.numThreads = static_cast<unsigned int>(number);
+            valid = true;
+        }
+        else if (option == "--tick-rate" && parseNumber(value, rate) && rate > 0 && std::isfinite(rate))
+        {
+            timeStep = static_cast<float>(1.0 / rate);
+            valid = true;
+        }
+
+        if (!valid)
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Simulation simulation(config);
+    simulation.player.startGame();
+
+    // spawn the whole wave up front so the timing covers a full world, not the spawn ramp
+    for (int i = 0; i < config.maxLanders; i++)
+    {
+        simulation.spawnLander();
+    }
+    for (int i = 0; i < config.maxHumanoids; i++)
+    {
+        simulation.spawnHumanoids();
+    }
+
+    sf::Clock clock;
+    long tick = 0;
+    while (tick < ticks && !simulation.isGameOver())
+    {
+        simulation.update(timeStep, scriptedInput(tick++));
+    }
+    float elapsed = clock.getElapsedTime().asSeconds();
+
+    printReport(simulation, tick, elapsed);
+    return 0;
+}
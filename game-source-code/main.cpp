@@ -1,13 +1,27 @@
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <string>
 #include <vector>
-#include "Game.h"
+#include "game.h"
 
-int main()
+// usage: game [--record FILE]   (the first game's controls are saved to last_session.rec by default)
+
+int main(int argc, char *argv[])
 {
-	Game game;
+	std::string recordingFile = "last_session.rec";
+	if (argc == 3 && std::string(argv[1]) == "--record")
+	{
+		recordingFile = argv[2];
+	}
+	else if (argc != 1)
+	{
+		std::cerr << "usage: game [--record FILE]" << std::endl;
+		return 1;
+	}
+
+	Game game(recordingFile);
 	game.run();
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -1,54 +1,47 @@
 #include "player.h"
-#include "laser.h"
-#include <SFML/Window/Event.hpp>
+#include "ProjectileStore.h"
+#include "ResourceCache.h"
+#include "Interpolation.h"
 #include <iostream>
 #include <SFML/Graphics.hpp>
 
 // Constant global variables defined here
 const int WINDOW_WIDTH = 1500;
 const int WINDOW_HEIGHT = 900;
-const float PLAYER_SPEED = 5.0f;
-const float LASER_SPEED = 10.0f;
+const float PLAYER_SPEED = 300.0f;   // pixels per second
+const double FUEL_BURN_RATE = 6.0;   // fuel used per second of movement
 const float LASER_COOLDOWN = 0.25f; // Reduced cooldown time
+const float FUEL_CAN_HIDDEN_TIME = 4.0f; // seconds before the fuel can appears
+const float FUEL_CAN_SHOWN_TIME = 6.0f;  // seconds it stays before it hides again
 const float PLAYER_X_SIZE = 0.2f;
 const float PLAYER_Y_SIZE = 0.2f;
 
 // The following code generates the player and their various physical properties
 
-Player::Player()
-    : PlayerSprite(), isPlaying(false), isFacingRight(true), fuel(200), hasFuelPowerUp(false), humanoidCaptured(false)
+Player::Player(const Random &random)
+    : laserCooldownTimer(LASER_COOLDOWN), PlayerSprite(), isPlaying(false), isFacingRight(true), laserTimer(NO_TIMER), fuelCanTimer(NO_TIMER),
+      fuelCanShowing(false), fuel(200), random(random), hasFuelPowerUp(false), humanoidCaptured(false)
 {
-    lastShotTime.restart(); // This restarts the clock
 
-    if (!PlayerTexture.loadFromFile("resources/8bitship.png"))
+    ResourceCache &resources = getResourceCache();
+    if (!resources.loadSprite(PlayerSprite, "resources/8bitship.png", true))
     {
         std::cerr << "Failed to load 8bitship.png" << std::endl;
     }
 
-    if (!laserBuffer.loadFromFile("resources/Gun.wav")) // the following are resources
-    {
-        std::cerr << "Failed to load gun.wav" << std::endl;
-    }
-    laserSound.setBuffer(laserBuffer);
-
-if (!fuelCanTexture.loadFromFile("resources/fuelcan.png"))
+if (!resources.loadSprite(fuelCanSprite, "resources/fuelcan.png"))
 {
      std::cerr << "Failed to load fuelcan.png" << std::endl;
 }
 
-if (!fuelBuffer.loadFromFile("resources/fuelsound.mp3")) // the following are resources
-    {
-        std::cerr << "Failed to load fuelsound.mp3" << std::endl;
-    }
-    fuelSound.setBuffer(fuelBuffer);
-
-    PlayerSprite.setTexture(PlayerTexture);
     PlayerSprite.setPosition(WINDOW_WIDTH / 2 - PlayerSprite.getLocalBounds().width / 2,
                              WINDOW_HEIGHT / 2 - PlayerSprite.getLocalBounds().height / 2);
 
     PlayerSprite.setScale(PLAYER_X_SIZE, PLAYER_Y_SIZE); // Adjust the scale as needed
-
-    PlayerTexture.setSmooth(true);
+    previousPosition = PlayerSprite.getPosition();
+    updateBounds();
+    mask = &resources.getPixelMask("resources/8bitship.png", getMaskSize(bounds));
+    mirroredMask = &resources.getPixelMask("resources/8bitship.png", getMaskSize(bounds), true);
 
     fuelBar.setSize(sf::Vector2f(fuel/2, 10));
     fuelBar.setFillColor(sf::Color::Red);            // Set the initial fuel bar color
@@ -58,7 +51,6 @@ if (!fuelBuffer.loadFromFile("resources/fuelsound.mp3")) // the following are re
     fuelBarOutline.setFillColor(sf::Color::Blue);            // Set the initial fuel bar color
     fuelBarOutline.setPosition(WINDOW_WIDTH - 130, 10); // Position at the top right corner
 
-    fuelCanSprite.setTexture(fuelCanTexture);
     fuelCanSprite.setScale( 0.10f, 0.10f);
     // fuelCan.setFillColor(sf::Color::Yellow);
     setFuelCanPosition();
@@ -81,100 +73,74 @@ void Player::moveRight()
 
 // This code checks how the game reacts to inputs
 
-void Player::handleInput(sf::RenderWindow &window, std::vector<Laser> &lasers)
+bool Player::applyInput(const InputState &input, ProjectileStore &projectiles, TimerWheel &timers, float deltaTime)
 {
-    sf::Event event;
-
-    while (window.pollEvent(event))
+    if (!isPlaying)
     {
-        if (event.type == sf::Event::Closed)
-        {
-            window.close();
-        }
-        else if (event.type == sf::Event::KeyPressed)
+        // firing on the splash screen starts the game, and the shot that started it cools down like any other
+        if (input.fire)
         {
-            if (event.key.code == sf::Keyboard::Space && !isPlaying)
-            {
-                if (lastShotTime.getElapsedTime().asSeconds() >= LASER_COOLDOWN)
-                {
-                    isPlaying = true;
-                    lastShotTime.restart();
-                }
-            }
-            else if (event.key.code == sf::Keyboard::Escape)
-            {
-                window.close();
-            }
+            isPlaying = true;
+            timers.cancel(laserTimer);
+            laserTimer = timers.schedule(LASER_COOLDOWN, nullptr);
         }
+        return false;
     }
 
     // This controls the movement of the player across the screen, preventing it from exceeding the dimensions of the screen
-    if (isPlaying)
+    if (input.up && PlayerSprite.getPosition().y > 0)
     {
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) && PlayerSprite.getPosition().y > 0)
-        {
-            PlayerSprite.move(0, -PLAYER_SPEED);
-            fuel = fuel - 0.1;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) && PlayerSprite.getPosition().y + PlayerSprite.getGlobalBounds().height < WINDOW_HEIGHT)
-        {
-            PlayerSprite.move(0, PLAYER_SPEED);
-            fuel = fuel - 0.1;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) && PlayerSprite.getPosition().x > 0.1 * WINDOW_WIDTH)
-        {
-            moveLeft();
-            PlayerSprite.move(-PLAYER_SPEED, 0);
-            fuel = fuel - 0.1;
-        }
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) && PlayerSprite.getPosition().x + PlayerSprite.getGlobalBounds().width < WINDOW_WIDTH + 100)
+        PlayerSprite.move(0, -PLAYER_SPEED * deltaTime);
+        fuel = fuel - FUEL_BURN_RATE * deltaTime;
+    }
+    if (input.down && PlayerSprite.getPosition().y + bounds.height < WINDOW_HEIGHT)
+    {
+        PlayerSprite.move(0, PLAYER_SPEED * deltaTime);
+        fuel = fuel - FUEL_BURN_RATE * deltaTime;
+    }
+    if (input.left && PlayerSprite.getPosition().x > 0.1 * WINDOW_WIDTH)
+    {
+        moveLeft();
+        PlayerSprite.move(-PLAYER_SPEED * deltaTime, 0);
+        fuel = fuel - FUEL_BURN_RATE * deltaTime;
+    }
+    if (input.right && PlayerSprite.getPosition().x + bounds.width < WINDOW_WIDTH + 100)
+    {
+        moveRight();
+        PlayerSprite.move(PLAYER_SPEED * deltaTime, 0);
+        fuel = fuel - FUEL_BURN_RATE * deltaTime;
+    }
+    updateBounds(); // every collision check this update reads the box from here
+
+    if (input.fire && !timers.isPending(laserTimer))
+    {
+        auto laserX = PlayerSprite.getPosition().x + 30.0f; // this uses addition for left-facing player
+        auto laserY = PlayerSprite.getPosition().y + bounds.height / 2;
+
+        // this adjusts the laser's starting position based on the player's direction
+        if (!isFacingRight) // this checks if the player is facing left
         {
-            moveRight();
-            PlayerSprite.move(PLAYER_SPEED, 0);
-            fuel = fuel - 0.1;
+            laserX -= bounds.width; // this subtracts for left-facing player
         }
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space))
+        if (!projectiles.spawnLaser(sf::Vector2f(laserX, laserY), isFacingRight)) // this passes the direction to the store
         {
-            if (lastShotTime.getElapsedTime().asSeconds() >= LASER_COOLDOWN)
-            {
-                auto laserX = PlayerSprite.getPosition().x + 30.0f; // this uses addition for left-facing player
-                auto laserY = PlayerSprite.getPosition().y + PlayerSprite.getGlobalBounds().height / 2;
-
-                // this adjusts the laser's starting position based on the player's direction
-                if (!isFacingRight) // this checks if the player is facing left
-                {
-                    laserX -= PlayerSprite.getGlobalBounds().width; // this subtracts for left-facing player
-                }
-
-                auto LaserShotNew = Laser(sf::Vector2f(laserX, laserY), isFacingRight); // this pases the direction to the Laser constructor
-                lasers.push_back(LaserShotNew);
-                lastShotTime.restart(); // Reset the cooldown timer
-                laserSound.play();
-            }
+            return false; // too many projectiles in flight, so the shot is dropped and the cooldown is not used
         }
+        laserTimer = timers.schedule(LASER_COOLDOWN, nullptr); // Reset the cooldown timer
+        return true;
     }
+    return false;
 }
 
-void Player::update(std::vector<Laser> &lasers)
+void Player::update()
 {
-    for (auto &laser : lasers)
-    {
-        laser.move();
-    }
-    lasers.erase(std::remove_if(lasers.begin(), lasers.end(),
-                                [](const Laser &laser)
-                                {
-                                    return laser.isOutOfBounds(WINDOW_WIDTH + 300);
-                                }),
-                 lasers.end());
-
     fuelBar.setSize(sf::Vector2f(fuel, 10));
 }
 
-void Player::draw(sf::RenderWindow &window)
+void Player::draw(sf::RenderWindow &window, float alpha)
 {
-    window.draw(PlayerSprite);
+    window.draw(PlayerSprite, interpolatedStates(previousPosition, PlayerSprite.getPosition(), alpha));
     window.draw(fuelBarOutline);
     window.draw(fuelBar);
     
@@ -189,6 +155,16 @@ sf::Vector2f Player::getPlayerPosition() const
     return PlayerSprite.getPosition();
 }
 
+void Player::savePreviousPosition()
+{
+    previousPosition = PlayerSprite.getPosition();
+}
+
+sf::Vector2f Player::getInterpolatedPosition(float alpha) const
+{
+    return interpolate(previousPosition, PlayerSprite.getPosition(), alpha);
+}
+
 void Player::startGame()
 {
     isPlaying = true;
@@ -206,37 +182,48 @@ void Player::setFuel(double fuelValue)
 
 void Player::setFuelCanPosition()
 {
-    float x = static_cast<float>(rand() % WINDOW_WIDTH);
+    float x = static_cast<float>(random.nextInt(WINDOW_WIDTH));
     float y = static_cast<float>(WINDOW_HEIGHT - 50); // Ground level
     fuelCanSprite.setPosition(sf::Vector2f(x, y));
-    fuelClock.restart();
+    fuelCanBounds = fuelCanSprite.getGlobalBounds();
+}
+
+void Player::startTimers(TimerWheel &timers)
+{
+    laserTimer = timers.schedule(LASER_COOLDOWN, nullptr);
+    scheduleFuelCan(timers);
+}
+
+void Player::scheduleFuelCan(TimerWheel &timers)
+{
+    timers.cancel(fuelCanTimer);
+    fuelCanShowing = false;
+    fuelCanTimer = timers.schedule(FUEL_CAN_HIDDEN_TIME, [this, &timers]()
+                                   {
+                                       setFuelCanPosition();
+                                       fuelCanShowing = true;
+                                       fuelCanTimer = timers.schedule(FUEL_CAN_SHOWN_TIME, [this, &timers]()
+                                                                      { scheduleFuelCan(timers); }); });
 }
 
 void Player::spwanFuel(sf::RenderWindow &window)
 {
-    if(fuelClock.getElapsedTime().asSeconds() <= 10 && fuelClock.getElapsedTime().asSeconds() > 4)
+    if(fuelCanShowing)
     {
         window.draw(fuelCanSprite);
     }
-    else if(fuelClock.getElapsedTime().asSeconds() >= 10)
-    {
-        fuelClock.restart();
-    }
-    else if(fuelClock.getElapsedTime().asSeconds() == 4)
-    {
-        setFuelCanPosition();
-    }
 }
 
-void Player::fuelCanCollision()
+bool Player::fuelCanCollision(TimerWheel &timers)
 {
-    if(PlayerSprite.getGlobalBounds().intersects(fuelCanSprite.getGlobalBounds()))
+    if(bounds.intersects(fuelCanBounds))
     {
-        fuelSound.play();
-        fuelClock.restart();
+        scheduleFuelCan(timers);
         setFuelCanPosition();
         setFuel(200);
+        return true;
     }
+    return false;
 }
 
 void Player::setHumanoidCaptured(bool value)
@@ -249,12 +236,23 @@ bool Player::isHumanoidCaptured() const
     return humanoidCaptured;
 }
 
-sf::FloatRect Player::getPlayerBounds() const
+const sf::FloatRect &Player::getPlayerBounds() const
+{
+    return bounds;
+}
+
+void Player::updateBounds()
+{
+    bounds = PlayerSprite.getGlobalBounds();
+}
+
+const PixelMask &Player::getPlayerMask() const
 {
-    return PlayerSprite.getGlobalBounds();
+    return PlayerSprite.getScale().x < 0 ? *mirroredMask : *mask;
 }
 
 void Player::setPlayerState(bool playing) {
     isPlaying = playing;
-    PlayerSprite.move(0, PLAYER_SPEED);
+    PlayerSprite.move(0, PLAYER_SPEED / 60.0f); // one 60 fps frame of movement
+    updateBounds();
 } 
\ No newline at end of file
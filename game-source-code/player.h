@@ -2,9 +2,12 @@
 #define PLAYER_H
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <SFML/Audio.hpp>
 #include <iostream>
-class Laser;
+#include "InputState.h"
+#include "Random.h"
+#include "TimerWheel.h"
+#include "PixelMask.h"
+class ProjectileStore;
 
 /**
  * @class Player
@@ -17,8 +20,10 @@ class Player
 public:
     /**
      * @brief Construct a new Player object.
+     *
+     * @param random The random stream used to place the fuel can.
      */
-    Player();
+    explicit Player(const Random &random = Random(1, FUEL_CAN_STREAM));
     /**
      * @brief Set the player's game state.
      *
@@ -26,25 +31,42 @@ public:
      */
     void setPlayerState(bool playing);
     /**
-     * @brief Handle player input and control the player character.
+     * @brief Move the player character and fire lasers according to the given controls.
      *
-     * @param window The SFML render window.
-     * @param lasers A vector of Laser objects.
+     * While the game has not started yet, firing starts it instead.
+     *
+     * @param input The controls held down for this update.
+     * @param projectiles The store new lasers are added to.
+     * @param timers The wheel the laser cooldown is scheduled on.
+     * @param deltaTime The time passed since the last update, in seconds.
+     * @return True if a laser was fired, false otherwise.
      */
-    void handleInput(sf::RenderWindow &window, std::vector<Laser> &lasers);
+    bool applyInput(const InputState &input, ProjectileStore &projectiles, TimerWheel &timers, float deltaTime);
     /**
      * @brief Update the player's character and game state.
-     *
-     * @param lasers A vector of Laser objects.
      */
-    void update(std::vector<Laser> &lasers);
+    void update();
 
     /**
      * @brief Draw the player's character on the game window.
      *
      * @param window The SFML render window.
+     * @param alpha How far the frame is between the last two updates, from 0 to 1.
+     */
+    void draw(sf::RenderWindow &window, float alpha = 1.0f);
+
+    /**
+     * @brief Remember the current position so drawing can interpolate from it.
      */
-    void draw(sf::RenderWindow &window);
+    void savePreviousPosition();
+
+    /**
+     * @brief Get the position to draw the player character at this frame.
+     *
+     * @param alpha How far the frame is between the last two updates, from 0 to 1.
+     * @return The position between the last two updates as an SFML vector.
+     */
+    sf::Vector2f getInterpolatedPosition(float alpha) const;
 
     /**
      * @brief Move the player character to the right.
@@ -78,9 +100,21 @@ public:
     /**
      * @brief Get the bounding box of the player character.
      *
-     * @return The bounding box of the player character as an SFML FloatRect.
+     * @return The bounding box of the player character as an SFML FloatRect, as of the last updateBounds().
+     */
+    const sf::FloatRect &getPlayerBounds() const;
+
+    /**
+     * @brief Work out the bounding box of the player character again, after its sprite was moved from outside.
      */
-    sf::FloatRect getPlayerBounds() const;
+    void updateBounds();
+
+    /**
+     * @brief Get which pixels of the player's bounding box are solid, facing the way the ship is drawn.
+     *
+     * @return The pixel mask, the size of the bounding box.
+     */
+    const PixelMask &getPlayerMask() const;
 
     /**
      * @brief Start the game.
@@ -89,10 +123,8 @@ public:
     float laserCooldownTimer;
     sf::Sprite PlayerSprite;
     bool isFacingRight; // this is to keep track of direction the ship is facing to orient the lasers properly
-    sf::Texture PlayerTexture;
     sf::RectangleShape fuelBarOutline;
     sf::RectangleShape fuelBar;
-    sf::Texture fuelCanTexture;
     sf::Sprite fuelCanSprite;
 
     //sf::RectangleShape fuelCan;
@@ -116,7 +148,21 @@ public:
     void setFuelCanPosition();
 
     /**
-     * @brief Spawn a fuel can on the game window.
+     * @brief Start the laser cooldown out pending and hide the fuel can until its timer shows it, as at the start of a game.
+     *
+     * @param timers The wheel the timers are scheduled on, which must outlive the player's use of it.
+     */
+    void startTimers(TimerWheel &timers);
+
+    /**
+     * @brief Hide the fuel can, and schedule it to appear somewhere new for a while before it hides again.
+     *
+     * @param timers The wheel the fuel can's timers are scheduled on.
+     */
+    void scheduleFuelCan(TimerWheel &timers);
+
+    /**
+     * @brief Draw the fuel can on the game window while it is showing.
      *
      * @param window The SFML render window.
      */
@@ -124,8 +170,11 @@ public:
 
     /**
      * @brief Handle a fuel can collision.
+     *
+     * @param timers The wheel the fuel can's timers are scheduled on.
+     * @return True if the fuel can was collected, false otherwise.
      */
-    void fuelCanCollision();
+    bool fuelCanCollision(TimerWheel &timers);
 
     /**
      * @brief Set whether a humanoid is captured.
@@ -144,15 +193,17 @@ public:
 private:
     bool isPlaying;
 
-    sf::Clock lastShotTime; // Add this variable to track the last shot time
-    sf::SoundBuffer laserBuffer;
-    sf::Sound laserSound;
-    sf::SoundBuffer fuelBuffer;
-    sf::Sound fuelSound;
-    sf::Clock laserClock; // this clock manages the laser direction
-    sf::Clock fuelClock;
+    TimerId laserTimer;   // pending while the laser is cooling down
+    TimerId fuelCanTimer; // the fuel can's next appearance or disappearance
+    bool fuelCanShowing;
 
     double fuel;
+    sf::Vector2f previousPosition;
+    sf::FloatRect bounds;        // the ship's bounding box, worked out once each time it moves
+    sf::FloatRect fuelCanBounds; // the fuel can's bounding box, worked out each time it is placed
+    const PixelMask *mask;         // the ship's solid pixels facing right, shared through the resource cache
+    const PixelMask *mirroredMask; // the same facing left
+    Random random;
     bool hasFuelPowerUp;
     bool humanoidCaptured;
     